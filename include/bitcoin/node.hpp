@@ -16,8 +16,12 @@
 
 #include <bitcoin/database.hpp>
 #include <bitcoin/network.hpp>
+#include <bitcoin/node/arrival_tracker.hpp>
 #include <bitcoin/node/block_arena.hpp>
 #include <bitcoin/node/block_memory.hpp>
+#include <bitcoin/node/block_pool.hpp>
+#include <bitcoin/node/candidate_window.hpp>
+#include <bitcoin/node/channel_speeds.hpp>
 #include <bitcoin/node/chase.hpp>
 #include <bitcoin/node/configuration.hpp>
 #include <bitcoin/node/define.hpp>
@@ -25,6 +29,8 @@
 #include <bitcoin/node/estimator.hpp>
 #include <bitcoin/node/events.hpp>
 #include <bitcoin/node/full_node.hpp>
+#include <bitcoin/node/numa.hpp>
+#include <bitcoin/node/peer_reputation.hpp>
 #include <bitcoin/node/settings.hpp>
 #include <bitcoin/node/validate.hpp>
 #include <bitcoin/node/version.hpp>
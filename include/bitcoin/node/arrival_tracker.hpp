@@ -0,0 +1,98 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_ARRIVAL_TRACKER_HPP
+#define LIBBITCOIN_NODE_ARRIVAL_TRACKER_HPP
+
+#include <unordered_map>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Not thread safe.
+/// Expected arrival of outstanding block requests on a channel, with a
+/// distribution of request latency (time from request to arrival). Latency
+/// is counted in power-of-two millisecond buckets, where bucket zero is less
+/// than one millisecond and the last bucket is unbounded.
+class BCN_API arrival_tracker
+{
+public:
+    DEFAULT_COPY_MOVE_DESTRUCT(arrival_tracker);
+
+    using clock = network::steady_clock;
+    static constexpr size_t buckets = 20;
+    typedef std_array<size_t, buckets> histogram;
+
+    /// A request is overdue when outstanding for factor times its expected
+    /// duration, where a non-positive factor disables overdue detection.
+    arrival_tracker(double factor=0.0) NOEXCEPT;
+
+    /// Record a request sent at the given time, where a zero expected
+    /// duration implies that the request cannot become overdue.
+    void expect(const system::hash_digest& hash, clock::time_point sent,
+        clock::duration expected) NOEXCEPT;
+
+    /// Record arrival and latency of the request, false if not outstanding.
+    bool arrive(const system::hash_digest& hash,
+        clock::time_point now) NOEXCEPT;
+
+    /// Forget the request without recording latency (left without arrival),
+    /// false if not outstanding.
+    bool forget(const system::hash_digest& hash) NOEXCEPT;
+
+    /// Any outstanding request is overdue at the given time.
+    bool is_overdue(clock::time_point now) const NOEXCEPT;
+
+    /// Forget all outstanding requests (latencies are retained).
+    void clear() NOEXCEPT;
+
+    /// Number of outstanding requests.
+    size_t size() const NOEXCEPT;
+
+    /// Number of latencies recorded.
+    size_t samples() const NOEXCEPT;
+
+    /// Latency counts by bucket.
+    const histogram& latencies() const NOEXCEPT;
+
+    /// Upper bound (milliseconds) of the bucket containing the fraction of
+    /// recorded latencies (e.g. 0.5 is median), zero if none recorded.
+    size_t percentile(double fraction) const NOEXCEPT;
+
+    /// Bucket of the latency.
+    static size_t to_bucket(clock::duration latency) NOEXCEPT;
+
+private:
+    struct request
+    {
+        clock::time_point sent;
+        clock::duration expected;
+    };
+
+    // These are not thread safe.
+    const double factor_;
+    std::unordered_map<system::hash_digest, request> requests_{};
+    histogram latencies_{};
+    size_t samples_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
@@ -19,19 +19,30 @@
 #ifndef LIBBITCOIN_NODE_BLOCK_ARENA_HPP
 #define LIBBITCOIN_NODE_BLOCK_ARENA_HPP
 
+#include <array>
+#include <atomic>
+#include <bitcoin/node/block_pool.hpp>
 #include <bitcoin/node/define.hpp>
+#include <bitcoin/node/numa.hpp>
 
 namespace libbitcoin {
 namespace node {
 
 /// Thread UNSAFE detachable linked-linear memory arena.
+/// The first chunk of each allocation is sized from a learned upper quantile
+/// of the allocation to wire size ratio, tracked independently for each wire
+/// size band. The configured multiple is used until a band is warmed up.
 class BCN_API block_arena
   : public arena
 {
 public:
     DELETE_COPY(block_arena);
     
-    block_arena(size_t multiple) NOEXCEPT;
+    /// Chunks are recycled by size class, up to 'retain' bytes held.
+    /// Chunks of at least 'huge' bytes are mapped to huge pages if nonzero.
+    /// Chunks are bound to NUMA 'node' unless unbound.
+    block_arena(size_t multiple, size_t retain=zero, size_t huge=zero,
+        size_t node=numa::unbound) NOEXCEPT;
     block_arena(block_arena&& other) NOEXCEPT;
     virtual ~block_arena() NOEXCEPT;
 
@@ -43,10 +54,48 @@ public:
     /// Finalize allocation and reset allocator, return total allocation.
     size_t detach() NOEXCEPT override;
 
-    /// Release all chunks chained to the address.
+    /// Release all chunks chained to the address (any thread).
     void release(void* address) NOEXCEPT override;
 
+    /// Chunk recycling pool (statistics are thread safe).
+    const block_pool& pool() const NOEXCEPT;
+
+    /// Learned allocation to wire size ratio for the band (thread safe).
+    double ratio(size_t wire_size) const NOEXCEPT;
+
+    /// Average number of chunks per detached allocation (thread safe).
+    double chain() const NOEXCEPT;
+
+    /// Detached allocations, and their total chunks and objects (thread safe).
+    size_t blocks() const NOEXCEPT;
+    size_t chunks() const NOEXCEPT;
+    size_t objects() const NOEXCEPT;
+
+    /// Total bytes and alignment padding of detached allocations (thread safe).
+    size_t bytes() const NOEXCEPT;
+    size_t padding() const NOEXCEPT;
+
 protected:
+    /// Number of wire size bands with independently learned ratios.
+    static constexpr size_t bands = 4;
+
+    /// Number of samples in a band before its ratio is used.
+    static constexpr size_t warmup = 16;
+
+    /// Target quantile of the learned ratio and its relative step.
+    static constexpr double quantile = 0.95;
+    static constexpr double rate = 0.05;
+
+    /// Blocks above the stripped size limit must carry witness data.
+    static constexpr size_t to_band(size_t wire_size) NOEXCEPT
+    {
+        constexpr size_t stripped = 1'000'000;
+        if (wire_size > stripped) return 3;
+        if (wire_size >= system::power2(18u)) return 2;
+        if (wire_size >= system::power2(16u)) return 1;
+        return 0;
+    }
+
     /// Determine alignment offset.
     static constexpr size_t to_aligned(size_t value, size_t align) NOEXCEPT
     {
@@ -58,22 +107,24 @@ protected:
         return (value + sub1(align)) & ~sub1(align);
     }
 
-    /// Malloc throws if memory is not allocated.
+    /// Malloc returns nullptr if memory is not allocated (push throws).
     virtual INLINE ALLOCATOR void* malloc_(size_t bytes) THROWS
     {
-        BC_PUSH_WARNING(NO_MALLOC_OR_FREE)
-        return std::malloc(bytes);
-        BC_POP_WARNING()
+        return pool_.allocate(bytes);
     }
 
     /// Free does not throw, behavior is undefined if address is incorrect.
     virtual INLINE void free_(void* address) NOEXCEPT
     {
-        BC_PUSH_WARNING(NO_MALLOC_OR_FREE)
-        std::free(address);
-        BC_POP_WARNING()
+        pool_.deallocate(address);
     }
 
+    /// Size of the first chunk for the wire size.
+    size_t first_size(size_t wire_size) const THROWS;
+
+    /// Update the learned ratio of the current allocation's band.
+    void learn(size_t allocated) NOEXCEPT;
+
     /// Link a memory chunk to the allocated stack.
     void push(size_t minimum=zero) THROWS;
 
@@ -108,12 +159,29 @@ protected:
     void do_deallocate(void* ptr, size_t bytes, size_t align) NOEXCEPT override;
     bool do_is_equal(const arena& other) const NOEXCEPT override;
 
+    // This is thread safe.
+    block_pool pool_;
+
     // These are unprotected, caller must guard.
     uint8_t* memory_map_;
     size_t multiple_;
     size_t offset_;
     size_t total_;
     size_t size_;
+    size_t wire_size_;
+    size_t links_;
+    size_t objects_;
+    size_t padding_;
+    std::array<size_t, bands> samples_;
+    std::array<double, bands> estimates_;
+
+    // These are thread safe (written only by the arena thread).
+    std::array<std::atomic<double>, bands> ratios_;
+    std::atomic<size_t> blocks_;
+    std::atomic<size_t> chunks_;
+    std::atomic<size_t> allocations_;
+    std::atomic<size_t> bytes_;
+    std::atomic<size_t> padded_;
 };
 
 } // namespace node
@@ -20,6 +20,9 @@
 #define LIBBITCOIN_NODE_BLOCK_MEMORY_HPP
 
 #include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <bitcoin/node/block_arena.hpp>
 #include <bitcoin/node/define.hpp>
 
@@ -27,6 +30,10 @@ namespace libbitcoin {
 namespace node {
 
 /// Thread SAFE linked-linear arena allocator.
+/// Each thread is lazily assigned an arena slot upon first use, and the slot
+/// is returned for reuse by a subsequent thread when the thread exits.
+/// If NUMA aware, slots are assigned from the arenas of the node on which the
+/// thread first runs, and arena chunks are bound to that node.
 class BCN_API block_memory
   : public network::memory
 {
@@ -34,18 +41,87 @@ public:
     DELETE_COPY_MOVE_DESTRUCT(block_memory);
 
     /// Per thread multiple of wire size for each linear allocation chunk.
-    /// Returns default_arena if multiple is zero or threads exceeded.
-    block_memory(size_t multiple, size_t threads) NOEXCEPT;
+    /// Arenas are created up front for 'threads' and thereafter on demand.
+    /// Per thread retention of freed chunks for recycling (zero disables).
+    /// Chunks of at least 'huge' bytes are mapped to huge pages if nonzero.
+    /// Arenas are kept per NUMA node, with chunks bound to it, if 'per_node'.
+    /// Returns default_arena if multiple is zero.
+    block_memory(size_t multiple, size_t threads, size_t retain=zero,
+        size_t huge=zero, bool per_node=false) NOEXCEPT;
 
     /// Each thread obtains an arena.
     arena* get_arena() NOEXCEPT override;
 
+    /// False if multiple is zero (default_arena).
+    bool enabled() const NOEXCEPT;
+
+    /// Deserialize a block into the calling thread's arena, with the chunk
+    /// chain released when the block is dropped (nullptr if invalid).
+    system::chain::block::cptr deserialize(const system::data_chunk& data,
+        bool witness) NOEXCEPT;
+
+    /// Number of arena slots assigned to threads (including reassignment).
+    size_t assignments() const NOEXCEPT;
+
+    /// Number of arenas created on demand, as no slot was free (enabled).
+    size_t fallbacks() const NOEXCEPT;
+
+    /// Chunk allocations satisfied by recycling, summed over arenas.
+    size_t hits() const NOEXCEPT;
+
+    /// Chunk allocations satisfied by the system, summed over arenas.
+    size_t misses() const NOEXCEPT;
+
+    /// Chunk allocations satisfied by memory mapping, summed over arenas.
+    size_t mapped() const NOEXCEPT;
+
+    /// Detached allocations, and their chunks and objects, summed over arenas.
+    size_t blocks() const NOEXCEPT;
+    size_t chunks() const NOEXCEPT;
+    size_t objects() const NOEXCEPT;
+
+    /// Detached bytes and their alignment padding, summed over arenas.
+    size_t bytes() const NOEXCEPT;
+    size_t padding() const NOEXCEPT;
+
+    /// Live chunk bytes and the sum of per arena peaks (an upper bound).
+    size_t live() const NOEXCEPT;
+    size_t peak() const NOEXCEPT;
+
+    /// Number of NUMA nodes over which arenas are kept.
+    size_t nodes() const NOEXCEPT;
+
 protected:
-    // This is thread safe.
-    std::atomic_size_t count_{ zero };
+    /// Arenas and free slots of a node, shared with threads that hold a slot.
+    struct registry
+    {
+        const size_t node;
+        std::mutex mutex{};
+        std::deque<block_arena> arenas{};
+        std::vector<size_t> free{};
+    };
+
+    using registry_ptr = std::shared_ptr<registry>;
+    using registries = std::vector<registry_ptr>;
+
+    /// Thread local slot assignments, returned upon thread exit.
+    struct slots;
+
+    /// Assign a free or new arena to the calling thread.
+    block_arena* assign(slots& local) NOEXCEPT;
+
+    /// Sum a statistic over all arenas.
+    template <typename Statistic>
+    size_t sum(const Statistic& statistic) const NOEXCEPT;
 
-    // This is protected by constructor init and thread_local indexation.
-    std::vector<block_arena> arenas_{};
+    // These are thread safe.
+    const size_t multiple_;
+    const size_t retain_;
+    const size_t huge_;
+    const size_t identity_;
+    const registries registries_;
+    std::atomic_size_t assignments_{ zero };
+    std::atomic_size_t fallbacks_{ zero };
 };
 
 } // namespace node
@@ -0,0 +1,179 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_BLOCK_POOL_HPP
+#define LIBBITCOIN_NODE_BLOCK_POOL_HPP
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <bitcoin/node/define.hpp>
+#include <bitcoin/node/numa.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Thread SAFE size-classed recycler of block_arena chunks.
+/// Chunks are allocated and locally recycled by the owning (allocating)
+/// thread. Chunks freed on any other thread are pushed to a lock-free return
+/// stack, which is drained by the owner upon its next allocation. Freed bytes
+/// in excess of the retention limit are returned to the system. Chunks at or
+/// above the huge page threshold are memory mapped and advised for huge pages,
+/// falling back to the system allocator when mapping is unavailable.
+/// Chunks of a node bound pool are mapped and bound to the NUMA node before
+/// first touch, so their pages are local to threads running on that node.
+class BCN_API block_pool
+{
+public:
+    DELETE_COPY(block_pool);
+
+    /// Retain up to 'retain' bytes of freed chunks (zero disables recycling).
+    /// Map chunks of at least 'huge' bytes to huge pages (zero disables),
+    /// where 'huge' is raised to the huge page size if below it.
+    /// Bind page sized and larger chunks to NUMA 'node' unless unbound.
+    block_pool(size_t retain, size_t huge=zero,
+        size_t node=numa::unbound) NOEXCEPT;
+    block_pool(block_pool&& other) NOEXCEPT;
+    virtual ~block_pool() NOEXCEPT;
+
+    block_pool& operator=(block_pool&& other) NOEXCEPT;
+
+    /// Allocate a chunk of at least 'bytes' (owner), nullptr on failure.
+    NODISCARD void* allocate(size_t bytes) NOEXCEPT;
+
+    /// Free a chunk obtained from allocate (any thread).
+    void deallocate(void* address) NOEXCEPT;
+
+    /// Allocations satisfied from recycled chunks.
+    size_t hits() const NOEXCEPT;
+
+    /// Allocations satisfied by the system allocator.
+    size_t misses() const NOEXCEPT;
+
+    /// Bytes of freed chunks currently held for reuse by the owner.
+    size_t retained() const NOEXCEPT;
+
+    /// Allocations satisfied by memory mapping.
+    size_t mapped() const NOEXCEPT;
+
+    /// Bytes of chunks currently allocated (excludes retained).
+    size_t live() const NOEXCEPT;
+
+    /// Highest value of live bytes.
+    size_t peak() const NOEXCEPT;
+
+    /// NUMA node of allocated chunks, or numa::unbound.
+    size_t node() const NOEXCEPT;
+
+protected:
+    /// Chunk prefix, overwritten by the arena link only beyond this header.
+    struct alignas(std::max_align_t) chunk
+    {
+        chunk* next;
+        size_t index;
+        size_t bytes;
+        bool mapped;
+    };
+
+    /// Huge mapped lengths are rounded up to the (largest common) huge page
+    /// size, and other mapped lengths to the (smallest common) page size.
+    static constexpr size_t huge_page = system::power2(21u);
+    static constexpr size_t page = system::power2(12u);
+
+    /// Size classes are four linear steps per power of two from 4KiB.
+    static constexpr size_t minimum_shift = 12;
+    static constexpr size_t minimum_size = system::power2(minimum_shift);
+    static constexpr size_t classes = 64;
+    static constexpr size_t unclassed = classes;
+
+    /// Size class index sufficient for 'bytes' (unclassed if too large).
+    static constexpr size_t to_class(size_t bytes) NOEXCEPT
+    {
+        using namespace system;
+        if (bytes <= minimum_size)
+            return zero;
+
+        // Leading three bits of (bytes - 1) determine the step.
+        const auto value = sub1(bytes);
+        const auto shift = floored_log2(value) - two;
+        const auto step = (value >> shift) - 3u;
+        const auto index = ((shift - (minimum_shift - two)) * 4u) + step;
+        return index < classes ? index : unclassed;
+    }
+
+    /// Chunk size of the size class index.
+    static constexpr size_t to_size(size_t index) NOEXCEPT
+    {
+        BC_ASSERT(index < classes);
+        const auto step = 4u + (index % 4u);
+        return step << ((minimum_shift - two) + (index / 4u));
+    }
+
+    /// Malloc returns nullptr if memory is not allocated.
+    virtual INLINE ALLOCATOR void* malloc_(size_t bytes) NOEXCEPT
+    {
+        BC_PUSH_WARNING(NO_MALLOC_OR_FREE)
+        return std::malloc(bytes);
+        BC_POP_WARNING()
+    }
+
+    /// Free does not throw, behavior is undefined if address is incorrect.
+    virtual INLINE void free_(void* address) NOEXCEPT
+    {
+        BC_PUSH_WARNING(NO_MALLOC_OR_FREE)
+        std::free(address);
+        BC_POP_WARNING()
+    }
+
+    /// Map returns nullptr if memory is not mapped, 'bytes' is page rounded.
+    /// Huge page backing is requested if 'huge' is set.
+    virtual void* map_(size_t bytes, bool huge) NOEXCEPT;
+
+    /// Unmap does not throw, behavior is undefined if address is incorrect.
+    virtual void unmap_(void* address, size_t bytes) NOEXCEPT;
+
+private:
+    bool is_owner() const NOEXCEPT;
+    void reclaim() NOEXCEPT;
+    chunk* acquire(size_t bytes) NOEXCEPT;
+    void recycle(chunk* item) NOEXCEPT;
+    void dispose(chunk* item) NOEXCEPT;
+    void clear() NOEXCEPT;
+    void add_live(size_t bytes) NOEXCEPT;
+
+    // These are thread safe.
+    size_t retain_;
+    size_t huge_;
+    size_t node_;
+    std::atomic<std::thread::id> owner_{};
+    std::atomic<chunk*> returned_{};
+    std::atomic_size_t retained_{};
+    std::atomic_size_t hits_{};
+    std::atomic_size_t misses_{};
+    std::atomic_size_t mapped_{};
+    std::atomic_size_t live_{};
+    std::atomic_size_t peak_{};
+
+    // These are protected by owner thread.
+    std::array<chunk*, classes> free_list_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
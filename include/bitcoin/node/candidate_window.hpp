@@ -0,0 +1,118 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_CANDIDATE_WINDOW_HPP
+#define LIBBITCOIN_NODE_CANDIDATE_WINDOW_HPP
+
+#include <deque>
+#include <shared_mutex>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Thread safe compact record of candidate block states by height.
+/// Each state is recorded against the header link at its height, so that a
+/// record is not returned once its height has been reorganized. States only
+/// advance for a given link, so a racing stale write cannot regress a state.
+/// Unknown implies that the state must be obtained from the store.
+class BCN_API candidate_window
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(candidate_window);
+
+    enum class state : uint8_t
+    {
+        /// Not recorded (or recorded for another link).
+        unknown,
+
+        /// Block is being archived by a channel, otherwise unknown.
+        claimed,
+
+        /// Block txs are archived, validation state not recorded.
+        associated,
+
+        /// Block txs are archived and the block was not validated.
+        checked,
+
+        /// Block is valid (or confirmable), or validation was bypassed.
+        valid
+    };
+
+    /// Records at or above floor plus 'limit' are ignored (not retained).
+    candidate_window(size_t limit=max_size_t) NOEXCEPT;
+
+    /// Record state of the link at height, ignored outside of the window or
+    /// if the recorded state for the same link is not lower.
+    void set(size_t height, const database::header_link& link,
+        state value) NOEXCEPT;
+
+    /// Record state of the link at height if none is recorded, false if any
+    /// is recorded or if below floor (heights below floor are archived).
+    /// True above the limit, as the claim cannot be recorded.
+    bool claim(size_t height, const database::header_link& link,
+        state value) NOEXCEPT;
+
+    /// Release a claim of the link at height that did not archive the block,
+    /// ignored if the recorded state for the link is not claimed.
+    void unclaim(size_t height, const database::header_link& link) NOEXCEPT;
+
+    /// Recorded state of the link at height.
+    state get(size_t height,
+        const database::header_link& link) const NOEXCEPT;
+
+    /// Recorded state of the link at height is at least associated.
+    bool is_associated(size_t height,
+        const database::header_link& link) const NOEXCEPT;
+
+    /// Discard records above the branch point, floor is lowered to the next
+    /// height if above it.
+    void regress(size_t branch_point) NOEXCEPT;
+
+    /// Discard records below height, floor is raised to height if below it.
+    void advance(size_t height) NOEXCEPT;
+
+    /// Lowest recorded height.
+    size_t floor() const NOEXCEPT;
+
+    /// Number of heights spanned by the window.
+    size_t size() const NOEXCEPT;
+
+private:
+    state get_(size_t height, const header_t& link) const NOEXCEPT;
+    void set_(size_t height, const header_t& link, state value) NOEXCEPT;
+
+    struct record
+    {
+        header_t link;
+        state value;
+    };
+
+    // This is thread safe.
+    const size_t limit_;
+
+    // These are protected by mutex.
+    size_t floor_{};
+    std::deque<record> records_{};
+    mutable std::shared_mutex mutex_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
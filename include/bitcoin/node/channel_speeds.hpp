@@ -0,0 +1,89 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_CHANNEL_SPEEDS_HPP
+#define LIBBITCOIN_NODE_CHANNEL_SPEEDS_HPP
+
+#include <unordered_map>
+#include <vector>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Not thread safe.
+/// Channel throughput, exponentially smoothed per channel, with the sum and
+/// sum of squares over channels maintained incrementally (constant time per
+/// update). Sums are recomputed once per round of updates to cancel floating
+/// point drift, and the median and median absolute deviation are computed on
+/// demand at most once per round (amortized constant time per update).
+class BCN_API channel_speeds
+{
+public:
+    DEFAULT_COPY_MOVE_DESTRUCT(channel_speeds);
+
+    /// Scale of median absolute deviation to standard deviation (normal).
+    static constexpr double mad_scale = 1.4826;
+
+    /// Smoothing is the weight of a new sample, clamped to (0, 1], where one
+    /// implies no smoothing.
+    channel_speeds(double smoothing=1.0) NOEXCEPT;
+
+    /// Add or update the channel sample, returns the smoothed speed.
+    double update(object_key channel, double speed) NOEXCEPT;
+
+    /// Remove the channel, false if not found.
+    bool erase(object_key channel) NOEXCEPT;
+
+    /// Channel with the lowest smoothed speed, false if empty.
+    bool slowest(object_key& channel) const NOEXCEPT;
+
+    /// Smoothed speed of the channel, zero if not found.
+    double speed(object_key channel) const NOEXCEPT;
+
+    /// Number of channels.
+    size_t size() const NOEXCEPT;
+
+    /// Statistics over smoothed channel speeds.
+    double sum() const NOEXCEPT;
+    double mean() const NOEXCEPT;
+    double variance() const NOEXCEPT;
+    double deviation() const NOEXCEPT;
+    double median() NOEXCEPT;
+    double mad() NOEXCEPT;
+
+private:
+    void refresh() NOEXCEPT;
+    void order() NOEXCEPT;
+
+    // These are not thread safe.
+    const double smoothing_;
+    std::unordered_map<object_key, double> speeds_{};
+    std::vector<double> scratch_{};
+    double sum_{};
+    double squares_{};
+    double median_{};
+    double mad_{};
+    size_t updates_{};
+    bool ordered_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
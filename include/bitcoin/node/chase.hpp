@@ -61,15 +61,16 @@ enum class chase
     /// Issued by 'block_in_31800' and handled by 'session_outbound'.
     starved,
 
-    /// Channel (slow) directed to split work and stop (object_t).
+    /// Channel (slow) directed to shed its unrequested work (object_t).
     /// Issued by 'session_outbound' and handled by 'block_in_31800'.
     split,
 
-    /// Channels (all with work) directed to split work and stop (peer_t).
+    /// Channels (all with work) directed to shed unrequested work (peer_t).
     /// Issued by 'session_outbound' and handled by 'block_in_31800'.
     stall,
 
-    /// Channels (all with work) directed to drop work and stop (peer_t).
+    /// Channels (all with work) directed to drop work above the branch point
+    /// (height_t), retaining the remainder and the connection.
     /// Issued by 'check' and handled by 'block_in_31800'.
     purge,
 
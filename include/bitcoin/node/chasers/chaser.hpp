@@ -19,6 +19,7 @@
 #ifndef LIBBITCOIN_NODE_CHASERS_CHASER_HPP
 #define LIBBITCOIN_NODE_CHASERS_CHASER_HPP
 
+#include <bitcoin/node/candidate_window.hpp>
 #include <bitcoin/node/configuration.hpp>
 #include <bitcoin/node/define.hpp>
 
@@ -123,6 +124,9 @@ protected:
     /// Thread safe synchronous archival interface.
     query& archive() const NOEXCEPT;
 
+    /// Thread safe record of candidate block states.
+    candidate_window& candidates() const NOEXCEPT;
+
     /// Configuration settings for all libraries.
     const node::configuration& node_config() const NOEXCEPT;
     const system::settings& system_settings() const NOEXCEPT;
@@ -142,6 +146,9 @@ protected:
     /// The confirmed chain is confirmed to maximum height or is current.
     bool is_recent() const NOEXCEPT;
 
+    /// The number of peer channels (counted, not quiet).
+    size_t channel_count() const NOEXCEPT;
+
     /// The height is at or below the top checkpoint.
     bool is_under_checkpoint(size_t height) const NOEXCEPT;
 
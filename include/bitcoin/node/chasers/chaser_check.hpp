@@ -19,8 +19,11 @@
 #ifndef LIBBITCOIN_NODE_CHASERS_CHASER_CHECK_HPP
 #define LIBBITCOIN_NODE_CHASERS_CHASER_CHECK_HPP
 
-#include <deque>
+#include <queue>
 #include <unordered_map>
+#include <utility>
+#include <vector>
+#include <bitcoin/node/channel_speeds.hpp>
 #include <bitcoin/node/chasers/chaser.hpp>
 #include <bitcoin/node/define.hpp>
 
@@ -42,11 +45,22 @@ public:
     /// Move half of map into returned map.
     static map_ptr split(const map_ptr& map) NOEXCEPT;
 
+    /// Move up to count items of map, in position order, into returned map.
+    static map_ptr take(const map_ptr& map, size_t count) NOEXCEPT;
+
+    /// Remove items of map above the branch point, returns count removed.
+    static size_t revoke(const map_ptr& map, size_t branch_point) NOEXCEPT;
+
+    /// Modeled serialized size of a mainnet block at the given height.
+    static size_t estimate_block_size(size_t height) NOEXCEPT;
+
+    /// The block size model applies to the configured chain (mainnet only).
+    static bool is_modeled(const system::settings& settings) NOEXCEPT;
+
     chaser_check(full_node& node) NOEXCEPT;
 
     /// Initialize chaser state.
     code start() NOEXCEPT override;
-    void stopping(const code& ec) NOEXCEPT override;
 
     /// Interface for protocols to provide performance data.
     virtual void update(object_key channel, uint64_t speed,
@@ -59,7 +73,6 @@ public:
         network::result_handler&& handler) NOEXCEPT;
 
 protected:
-    virtual void handle_purged(const code& ec) NOEXCEPT;
     virtual bool handle_chase(const code& ec, chase event_,
         event_value value) NOEXCEPT;
 
@@ -69,7 +82,6 @@ protected:
     virtual void do_advanced(height_t height) NOEXCEPT;
     virtual void do_headers(height_t branch_point) NOEXCEPT;
     virtual void do_regressed(height_t branch_point) NOEXCEPT;
-    virtual void do_handle_purged(const code& ec) NOEXCEPT;
     virtual void do_get_hashes(const map_handler& handler) NOEXCEPT;
     virtual void do_put_hashes(const map_ptr& map,
         const network::result_handler& handler) NOEXCEPT;
@@ -81,33 +93,59 @@ protected:
 
 private:
     static constexpr size_t minimum_for_standard_deviation = 4;
-    typedef std::unordered_map<object_key, double> speeds;
-    typedef std::deque<map_ptr> maps;
+    static constexpr size_t slow_strikes = 3;
+    static constexpr size_t endgame_blocks = 100;
+    typedef std::unordered_map<object_key, size_t> strikes;
+
+    // Pooled work is a min-heap on the first height of each map, so that
+    // returned gap-filling work is reassigned ahead of higher windows.
+    typedef std::pair<size_t, map_ptr> pooled;
+    struct later
+    {
+        bool operator()(const pooled& left,
+            const pooled& right) const NOEXCEPT
+        {
+            return left.first > right.first;
+        }
+    };
+    typedef std::priority_queue<pooled, std::vector<pooled>, later> maps;
 
     map_ptr get_map() NOEXCEPT;
     size_t set_unassociated() NOEXCEPT;
-    size_t get_inventory_size() const NOEXCEPT;
+    bool set_endgame(object_key channel) NOEXCEPT;
+    size_t get_inventory_size() NOEXCEPT;
+    size_t get_map_size(size_t height) const NOEXCEPT;
+    size_t get_lookahead() const NOEXCEPT;
+    bool is_associated(size_t height) const NOEXCEPT;
+    bool is_recorded(size_t height) const NOEXCEPT;
+    bool is_recorded(size_t height,
+        const database::header_link& link) const NOEXCEPT;
     bool set_map(const map_ptr& map) NOEXCEPT;
-
-    void start_tracking() NOEXCEPT;
-    void stop_tracking() NOEXCEPT;
-    bool purging() const NOEXCEPT;
+    size_t revoke_maps(size_t branch_point) NOEXCEPT;
 
     // These are thread safe.
     const float allowed_deviation_;
+    const bool median_deviation_;
     const size_t maximum_concurrency_;
     const size_t maximum_height_;
     const size_t connections_;
+    const bool modeled_;
+    const size_t map_bytes_;
+    const size_t lookahead_bytes_;
     const size_t step_;
 
     // These are protected by strand.
     size_t inventory_{};
+    size_t unassociated_{};
+    size_t counted_{};
+    size_t channels_{};
     size_t requested_{};
     size_t advanced_{};
-    job::ptr job_{};
+    size_t endgames_{};
+    size_t endgame_{};
 
-    // TODO: optimize, default bucket count is around 8.
-    speeds speeds_{};
+    channel_speeds speeds_;
+    strikes strikes_{};
     maps maps_{};
 };
 
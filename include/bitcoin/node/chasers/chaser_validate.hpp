@@ -20,6 +20,9 @@
 #define LIBBITCOIN_NODE_CHASERS_CHASER_VALIDATE_HPP
 
 #include <atomic>
+#include <latch>
+#include <memory>
+#include <bitcoin/node/block_memory.hpp>
 #include <bitcoin/node/chasers/chaser.hpp>
 #include <bitcoin/node/define.hpp>
 
@@ -64,6 +67,10 @@ protected:
     virtual void do_bump(height_t height) NOEXCEPT;
 
     /// Validation.
+    virtual code get_block_state(size_t height,
+        const header_link& link) const NOEXCEPT;
+    virtual system::chain::block::cptr get_block(
+        const header_link& link) NOEXCEPT;
     virtual void post_block(const header_link& link, bool bypass) NOEXCEPT;
     virtual void validate_block(const header_link& link, bool bypass) NOEXCEPT;
     virtual code validate(bool& batched, bool& capturing, bool bypass,
@@ -96,6 +103,9 @@ protected:
     bool stranded() const NOEXCEPT override;
 
 private:
+    /// Validated blocks between block memory reports.
+    static constexpr size_t allocation_interval = 1'000;
+
     using atomic_counter = std::atomic<size_t>;
     struct counters
     {
@@ -124,16 +134,24 @@ private:
         size_t denominator) const NOEXCEPT;
     void log_captures() const NOEXCEPT;
 
+    // Placement helpers.
+    using latch_ptr = std::shared_ptr<std::latch>;
+    void pin_threads() NOEXCEPT;
+    void do_pin(size_t thread, const latch_ptr& arrived) NOEXCEPT;
+
     // Batching helpers.
     bool is_residual() NOEXCEPT;
     bool is_mature(bool residual) NOEXCEPT;
     std::string log_rate(const std::string& name, size_t signatures,
         size_t milliseconds) const NOEXCEPT;
+    void log_allocation() const NOEXCEPT;
+    void fire_allocation() NOEXCEPT;
 
     // This is not thread safe.
     network::threadpool validation_threadpool_;
 
     // These are thread safe.
+    block_memory validation_memory_;
     network::asio::strand validation_strand_;
     atomic_counter validate_backlog_{};
     std::atomic_bool disk_recovering_{};
@@ -142,6 +160,7 @@ private:
     ////std::atomic_bool verifying_{};
     std::atomic_bool draining_{};
     atomic_counter writers_{};
+    atomic_counter pinned_{};
     counters counters_{};
     stopper stopping_{};
 
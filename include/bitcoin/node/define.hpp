@@ -61,10 +61,8 @@ typedef database::store<database::mmap> store;
 typedef database::query<store> query;
 
 /// Work types.
-typedef network::race_all<const code&> job;
 typedef std::shared_ptr<database::associations> map_ptr;
-typedef std::function<void(const code&, const map_ptr&,
-    const job::ptr&)> map_handler;
+typedef std::function<void(const code&, const map_ptr&)> map_handler;
 
 /// Event desubscriber key type.
 using object_key = uint64_t;
@@ -52,6 +52,7 @@ enum error_t : uint8_t
     sacrificed_channel,
     suspended_channel,
     suspended_service,
+    disfavored_channel,
 
     /// blockchain
     orphan_block,
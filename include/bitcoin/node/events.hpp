@@ -66,6 +66,14 @@ enum events : uint8_t
     schnorr_secs,        // schnorr batch verify timespan in seconds.
     silent_secs,         // silent payment scan timespan in seconds.
 
+    /// Block memory (validation arenas).
+    memory_bytes,        // average arena bytes allocated per block.
+    memory_chunks,       // average arena chunks per block, in hundredths.
+    memory_padding,      // average alignment padding bytes per block.
+    memory_live,         // arena chunk bytes currently allocated.
+    memory_peak,         // peak arena chunk bytes allocated (sum of arenas).
+    memory_fallbacks,    // arenas created on demand (none was free).
+
     unknown
 };
 
@@ -19,10 +19,13 @@
 #ifndef LIBBITCOIN_NODE_FULL_NODE_HPP
 #define LIBBITCOIN_NODE_FULL_NODE_HPP
 
+#include <bitcoin/node/block_memory.hpp>
+#include <bitcoin/node/candidate_window.hpp>
 #include <bitcoin/node/chasers/chasers.hpp>
 #include <bitcoin/node/configuration.hpp>
 #include <bitcoin/node/define.hpp>
 #include <bitcoin/node/estimator.hpp>
+#include <bitcoin/node/peer_reputation.hpp>
 #include <bitcoin/node/sessions/sessions.hpp>
 
 namespace libbitcoin {
@@ -132,6 +135,21 @@ public:
     ////const network::settings& network_settings() const NOEXCEPT override;
     virtual const node::settings& node_settings() const NOEXCEPT;
 
+    /// Block memory for deserialization of inbound messages (network threads).
+    /// Overrides the network accessor (covariant return), through which the
+    /// network message deserializers obtain arenas.
+    block_memory& get_memory() NOEXCEPT override;
+
+    /// Thread safe record of candidate block states, shared by chasers.
+    virtual candidate_window& candidates() NOEXCEPT;
+
+    /// Thread safe history of block delivery by peer address.
+    virtual peer_reputation& reputation() NOEXCEPT;
+
+    /// Dedicated threadpool for block identification and storage (ingest),
+    /// has no threads (and must not be posted to) if ingest is not enabled.
+    virtual network::asio::io_context& ingest_service() NOEXCEPT;
+
     /// The candidate|confirmed chain is current.
     virtual bool is_current_chain(bool confirmed) const NOEXCEPT;
 
@@ -185,6 +203,10 @@ private:
     const configuration& config_;
     const time_t start_time_;
     query& query_;
+    block_memory memory_;
+    candidate_window candidates_;
+    peer_reputation reputation_;
+    network::threadpool ingest_threadpool_;
 
     // These are protected by strand.
     chaser_block chaser_block_;
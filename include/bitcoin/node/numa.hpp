@@ -0,0 +1,53 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_NUMA_HPP
+#define LIBBITCOIN_NODE_NUMA_HPP
+
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Thread SAFE NUMA topology, memory binding and thread placement.
+/// Implemented via Linux system interfaces, elsewhere a single node is
+/// reported and binding/pinning are unsupported (return false).
+class BCN_API numa
+{
+public:
+    /// Sentinel for memory that is not bound to a node.
+    static constexpr size_t unbound = max_size_t;
+
+    /// Number of configured NUMA nodes (at least one).
+    static size_t nodes() NOEXCEPT;
+
+    /// Node of the processor currently executing the calling thread.
+    static size_t node() NOEXCEPT;
+
+    /// Prefer allocation of the page aligned range from the node.
+    /// Effective only for pages not yet touched (faulted in).
+    static bool bind(void* address, size_t bytes, size_t node) NOEXCEPT;
+
+    /// Restrict the calling thread to the processors of the node.
+    static bool pin(size_t node) NOEXCEPT;
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,124 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_PEER_REPUTATION_HPP
+#define LIBBITCOIN_NODE_PEER_REPUTATION_HPP
+
+#include <filesystem>
+#include <shared_mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+/// Thread safe compact history of block delivery by peer address.
+/// Delivery rate is exponentially smoothed, and stalls and slow-channel drops
+/// are counted against performance samples. The history is persisted across
+/// restarts as text (one peer per line), where counts are halved upon load so
+/// that old failures are eventually forgotten.
+class BCN_API peer_reputation
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(peer_reputation);
+
+    /// Failures required (and exceeding samples) to consider a peer poor.
+    static constexpr size_t poor_failures = 3;
+
+    /// Capacity is the maximum number of peers recorded and persisted (the
+    /// least evidenced is evicted upon insert), smoothing is the weight of a
+    /// new rate sample, clamped to (0, 1].
+    peer_reputation(size_t capacity=4096, double smoothing=0.5) NOEXCEPT;
+
+    /// Peer key is the serialized address without port, as the port of an
+    /// inbound peer is ephemeral (a new key upon each connection).
+    static std::string to_key(const auto& address) NOEXCEPT
+    {
+        BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+        std::ostringstream stream{};
+        stream << address;
+        const auto key = stream.str();
+        BC_POP_WARNING()
+        return to_host(key);
+    }
+
+    /// Serialized address without its port, unchanged if there is none.
+    static std::string to_host(const std::string& address) NOEXCEPT;
+
+    /// Record a delivery rate sample (bytes per second) for the peer.
+    void delivered(const std::string& peer, double rate) NOEXCEPT;
+
+    /// Record a stall of the peer (no delivery with outstanding work).
+    void stalled(const std::string& peer) NOEXCEPT;
+
+    /// Record a drop of the peer as a slow channel.
+    void dropped(const std::string& peer) NOEXCEPT;
+
+    /// Smoothed rate discounted by failures, zero if not recorded.
+    double score(const std::string& peer) const NOEXCEPT;
+
+    /// Midrank of the peer's score among recorded peers, where peers of equal
+    /// score (including itself) count as half lower. One half if the peer is
+    /// not recorded or is the only record (ranks at the median).
+    double rank(const std::string& peer) const NOEXCEPT;
+
+    /// The peer has failed at least poor_failures times and more often than
+    /// it has delivered.
+    bool is_poor(const std::string& peer) const NOEXCEPT;
+
+    /// Number of recorded peers.
+    size_t size() const NOEXCEPT;
+
+    /// Replace history with the file, false if not found or invalid.
+    bool load(const std::filesystem::path& file) NOEXCEPT;
+
+    /// Write history (up to capacity, most evidenced) to the file.
+    bool save(const std::filesystem::path& file) const NOEXCEPT;
+
+private:
+    struct record
+    {
+        double rate;
+        uint32_t samples;
+        uint32_t stalls;
+        uint32_t drops;
+    };
+
+    typedef std::unordered_map<std::string, record> records;
+
+    record& get_(const std::string& peer) NOEXCEPT;
+
+    static double score(const record& value) NOEXCEPT;
+    static uint32_t failures(const record& value) NOEXCEPT;
+    static uint32_t evidence(const record& value) NOEXCEPT;
+
+    // These are thread safe.
+    const size_t capacity_;
+    const double smoothing_;
+
+    // These are protected by mutex.
+    records records_{};
+    mutable std::shared_mutex mutex_{};
+};
+
+} // namespace node
+} // namespace libbitcoin
+
+#endif
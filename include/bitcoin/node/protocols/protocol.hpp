@@ -20,10 +20,12 @@
 #define LIBBITCOIN_NODE_PROTOCOLS_PROTOCOL_HPP
 
 #include <memory>
+#include <bitcoin/node/candidate_window.hpp>
 #include <bitcoin/node/channels/channels.hpp>
 #include <bitcoin/node/configuration.hpp>
 #include <bitcoin/node/define.hpp>
 #include <bitcoin/node/estimator.hpp>
+#include <bitcoin/node/peer_reputation.hpp>
 
 // Only session.hpp.
 #include <bitcoin/node/sessions/session.hpp>
@@ -58,6 +60,12 @@ protected:
     /// Thread safe synchronous archival interface.
     query& archive() const NOEXCEPT;
 
+    /// Thread safe record of candidate block states.
+    candidate_window& candidates() const NOEXCEPT;
+
+    /// Thread safe history of block delivery by peer address.
+    peer_reputation& reputation() const NOEXCEPT;
+
     /// Configuration settings for all libraries.
     virtual const node::configuration& node_config() const NOEXCEPT;
     virtual const system::settings& system_settings() const NOEXCEPT;
@@ -42,7 +42,10 @@ public:
         block_type_(session->node_settings().require_witness ?
             type_id::witness_block : type_id::block),
         node_pruned_(session->node_settings().limited_blocks),
+        ingest_(to_bool(session->node_settings().ingest_threads)),
+        ingest_strand_(session->ingest_service().get_executor()),
         map_(chaser_check::empty_map()),
+        unrequested_(chaser_check::empty_map()),
         network::tracker<protocol_block_in_31800>(session->log)
     {
     }
@@ -64,9 +67,9 @@ protected:
     virtual bool handle_chase(const code& ec, chase event_,
         event_value value) NOEXCEPT;
 
-    /// Manage work splitting.
+    /// Manage work shedding.
     bool is_idle() const NOEXCEPT override;
-    virtual void do_purge(peer_t) NOEXCEPT;
+    virtual void do_purge(height_t branch_point) NOEXCEPT;
     virtual void do_split(peer_t) NOEXCEPT;
     virtual void do_stall(peer_t) NOEXCEPT;
     virtual void do_report(count_t count) NOEXCEPT;
@@ -76,10 +79,40 @@ protected:
         const network::messages::peer::block::cptr& message) NOEXCEPT;
 
 private:
+    // Blocks in flight per channel (the remainder of work is sheddable), set
+    // from smoothed rate and round trip (bandwidth-delay) with headroom.
+    static constexpr size_t minimum_depth = 2;
+    static constexpr size_t initial_depth = 100;
+    static constexpr size_t maximum_depth = 2'000;
+    static constexpr double depth_headroom = 2.0;
+    static constexpr double smoothing = 0.25;
+    static constexpr double rate_period_seconds = 1.0;
+
     code identify(const system::chain::block_view& block,
         const system::chain::context& ctx, bool bypass) const NOEXCEPT;
-
-    void send_get_data(const map_ptr& map, const job::ptr& job) NOEXCEPT;
+    code ingest(const network::messages::peer::block::cptr& message,
+        const database::association& item, bool bypass) NOEXCEPT;
+    code commit(const network::messages::peer::block::cptr& message,
+        const database::association& item, bool checked,
+        bool bypass) NOEXCEPT;
+    void do_ingest(const network::messages::peer::block::cptr& message,
+        const database::association& item, bool checked,
+        bool bypass) NOEXCEPT;
+    void handle_ingested(const code& ec,
+        const network::messages::peer::block::cptr& message,
+        const system::hash_digest& hash) NOEXCEPT;
+
+    void send_get_data(const map_ptr& map) NOEXCEPT;
+    void request() NOEXCEPT;
+    void fetch() NOEXCEPT;
+    void refill() NOEXCEPT;
+    void drop(const database::associations::iterator& it,
+        size_t size) NOEXCEPT;
+    bool shed() NOEXCEPT;
+    bool shed_tail() NOEXCEPT;
+    void sample(size_t bytes) NOEXCEPT;
+    void seed_depth() NOEXCEPT;
+    void reset_sample() NOEXCEPT;
     network::messages::peer::get_data create_get_data(
         const database::associations& map) const NOEXCEPT;
 
@@ -87,17 +120,29 @@ private:
     bool is_under_checkpoint(size_t height) const NOEXCEPT;
     type_id to_block_type(const database::association& item) const NOEXCEPT;
     void handle_put_hashes(const code& ec, size_t count) NOEXCEPT;
-    void handle_get_hashes(const code& ec, const map_ptr& map,
-        const job::ptr& job) NOEXCEPT;
+    void handle_get_hashes(const code& ec, const map_ptr& map) NOEXCEPT;
 
     // These are thread safe.
     const size_t top_checkpoint_height_;
     const type_id block_type_;
     const bool node_pruned_;
+    const bool ingest_;
+
+    // This is the ingest threadpool strand (per channel).
+    network::asio::strand ingest_strand_;
 
     // These are protected by strand.
     map_ptr map_;
-    job::ptr job_{};
+    map_ptr unrequested_;
+    bool fetching_{};
+    bool exhausted_{};
+    size_t depth_{ initial_depth };
+    double rate_{};
+    double delay_{};
+    double size_{};
+    size_t received_{};
+    network::steady_clock::time_point sampled_{};
+    network::steady_clock::time_point requested_{};
 
     std_vector<system::chain::block::cptr> blocks_{};
 };
@@ -19,6 +19,7 @@
 #ifndef LIBBITCOIN_NODE_PROTOCOL_PERFORMER_HPP
 #define LIBBITCOIN_NODE_PROTOCOL_PERFORMER_HPP
 
+#include <bitcoin/node/arrival_tracker.hpp>
 #include <bitcoin/node/define.hpp>
 #include <bitcoin/node/protocols/protocol_peer.hpp>
 
@@ -42,15 +43,38 @@ protected:
       : node::protocol_peer(session, channel),
         deviation_(session->node_settings().allowed_deviation > 0.0),
         enabled_(enabled && to_bool(session->node_settings().sample_period_seconds)),
+        deadlines_(session->node_settings().stall_factor > 0.0),
         performance_timer_(system::emplace_shared<network::deadline>(session->log,
             channel->strand(), session->node_settings().sample_period())),
+        arrival_timer_(system::emplace_shared<network::deadline>(session->log,
+            channel->strand(), arrival_period)),
+        arrivals_(session->node_settings().stall_factor),
         network::tracker<protocol_performer>(session->log)
     {
     }
 
     virtual bool is_idle() const NOEXCEPT = 0;
 
+    /// Track expected arrival of a requested block (zero if not known), a
+    /// channel is stalled when a request is overdue by the stall factor.
+    virtual void expect(const system::hash_digest& hash,
+        network::steady_clock::duration expected) NOEXCEPT;
+
+    /// Record arrival of a requested block (latency).
+    virtual void arrived(const system::hash_digest& hash) NOEXCEPT;
+
+    /// Stop tracking a requested block that is no longer expected (revoked).
+    virtual void forget(const system::hash_digest& hash) NOEXCEPT;
+
+    /// Outstanding requests and latency distribution of the channel.
+    const arrival_tracker& arrivals() const NOEXCEPT;
+
 private:
+    static constexpr network::steady_clock::duration arrival_period =
+        std::chrono::seconds(1);
+
+    void handle_arrival_timer(const code& ec) NOEXCEPT;
+    void start_arrival_timer() NOEXCEPT;
     void handle_performance_timer(const code& ec) NOEXCEPT;
     void handle_send_performance(const code& ec) NOEXCEPT;
     void do_handle_performance(const code& ec) NOEXCEPT;
@@ -60,11 +84,15 @@ private:
     // These are thread safe.
     const bool deviation_;
     const bool enabled_;
+    const bool deadlines_;
 
     // These are protected by strand.
     uint64_t bytes_{ zero };
     network::steady_clock::time_point start_{};
     network::deadline::ptr performance_timer_;
+    network::deadline::ptr arrival_timer_;
+    arrival_tracker arrivals_;
+    bool arrival_timing_{};
 };
 
 } // namespace node
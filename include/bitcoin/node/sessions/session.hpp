@@ -19,9 +19,11 @@
 #ifndef LIBBITCOIN_NODE_SESSIONS_SESSION_HPP
 #define LIBBITCOIN_NODE_SESSIONS_SESSION_HPP
 
+#include <bitcoin/node/candidate_window.hpp>
 #include <bitcoin/node/configuration.hpp>
 #include <bitcoin/node/define.hpp>
 #include <bitcoin/node/estimator.hpp>
+#include <bitcoin/node/peer_reputation.hpp>
 
 namespace libbitcoin {
 namespace node {
@@ -96,6 +98,15 @@ public:
     /// Thread safe synchronous archival interface.
     node::query& archive() const NOEXCEPT;
 
+    /// Thread safe record of candidate block states.
+    candidate_window& candidates() const NOEXCEPT;
+
+    /// Thread safe history of block delivery by peer address.
+    peer_reputation& reputation() const NOEXCEPT;
+
+    /// Dedicated threadpool for block identification and storage.
+    network::asio::io_context& ingest_service() const NOEXCEPT;
+
     /// Configuration settings for all libraries.
     virtual const node::configuration& node_config() const NOEXCEPT;
     virtual const system::settings& system_settings() const NOEXCEPT;
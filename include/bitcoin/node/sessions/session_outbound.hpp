@@ -34,6 +34,10 @@ public:
     using base::base;
 
 protected:
+    /// Peers with a poor delivery history are declined.
+    void attach_handshake(const channel_ptr& channel,
+        network::result_handler&& handler) NOEXCEPT override;
+
     /// Outbound connections require the configured node services.
     uint64_t services_required() const NOEXCEPT override
     {
@@ -35,6 +35,7 @@ public:
 
     /// Properties.
     uint32_t threads;
+    uint32_t ingest_threads;
     bool delay_inbound;
     bool headers_first;
     bool thread_priority;
@@ -46,10 +47,21 @@ public:
     bool require_witness;
     bool provide_filters;
     bool limited_blocks;
+    bool numa_memory;
+    bool numa_pinning;
+    bool median_deviation;
     float allowed_deviation;
+    float speed_smoothing;
+    float stall_factor;
     float minimum_fee_rate;
     float minimum_bump_rate;
     uint64_t batch_signatures;
+    uint64_t huge_page_threshold;
+    uint32_t allocation_multiple;
+    uint32_t inbound_allocation_multiple;
+    uint64_t allocation_retain;
+    uint64_t download_map_bytes;
+    uint64_t lookahead_bytes;
     uint16_t announcement_cache;
     uint16_t fee_estimate_horizon;
     uint32_t maximum_height;
@@ -59,6 +71,7 @@ public:
     uint32_t currency_window_minutes;
     uint16_t warn_dirty_background_ratio;
     uint16_t warn_dirty_ratio;
+    std::filesystem::path reputation_file;
     ////uint64_t snapshot_bytes;
     ////uint32_t snapshot_valid;
     ////uint32_t snapshot_confirm;
@@ -0,0 +1,130 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/arrival_tracker.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+using namespace std::chrono;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+arrival_tracker::arrival_tracker(double factor) NOEXCEPT
+  : factor_(factor > 0.0 ? factor : 0.0)
+{
+}
+
+void arrival_tracker::expect(const hash_digest& hash, clock::time_point sent,
+    clock::duration expected) NOEXCEPT
+{
+    requests_.insert_or_assign(hash, request{ sent, expected });
+}
+
+bool arrival_tracker::arrive(const hash_digest& hash,
+    clock::time_point now) NOEXCEPT
+{
+    const auto it = requests_.find(hash);
+    if (it == requests_.end())
+        return false;
+
+    ++latencies_.at(to_bucket(now - it->second.sent));
+    ++samples_;
+    requests_.erase(it);
+    return true;
+}
+
+bool arrival_tracker::forget(const hash_digest& hash) NOEXCEPT
+{
+    return !is_zero(requests_.erase(hash));
+}
+
+bool arrival_tracker::is_overdue(clock::time_point now) const NOEXCEPT
+{
+    if (is_zero(factor_))
+        return false;
+
+    return std::any_of(requests_.begin(), requests_.end(),
+        [&](const auto& item) NOEXCEPT
+        {
+            const auto& value = item.second;
+            return value.expected > clock::duration::zero() &&
+                duration<double>(now - value.sent).count() >
+                    factor_ * duration<double>(value.expected).count();
+        });
+}
+
+void arrival_tracker::clear() NOEXCEPT
+{
+    requests_.clear();
+}
+
+size_t arrival_tracker::size() const NOEXCEPT
+{
+    return requests_.size();
+}
+
+size_t arrival_tracker::samples() const NOEXCEPT
+{
+    return samples_;
+}
+
+const arrival_tracker::histogram& arrival_tracker::latencies() const NOEXCEPT
+{
+    return latencies_;
+}
+
+size_t arrival_tracker::percentile(double fraction) const NOEXCEPT
+{
+    if (is_zero(samples_))
+        return zero;
+
+    const auto scaled = std::clamp(fraction, 0.0, 1.0) * to_floating(samples_);
+    const auto rank = std::max(one, to_ceilinged_integer<size_t>(scaled));
+
+    size_t count{};
+    for (size_t bucket = 0; bucket < buckets; ++bucket)
+    {
+        count += latencies_.at(bucket);
+        if (count >= rank)
+            return power2(bucket);
+    }
+
+    return power2(sub1(buckets));
+}
+
+// static
+size_t arrival_tracker::to_bucket(clock::duration latency) NOEXCEPT
+{
+    const auto ms = duration_cast<milliseconds>(latency).count();
+    if (ms <= 0)
+        return zero;
+
+    return std::min(add1(floored_log2(sign_cast<uint64_t>(ms))),
+        sub1(buckets));
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
@@ -19,6 +19,8 @@
 #include <bitcoin/node/block_arena.hpp>
 
 #include <algorithm>
+#include <utility>
+#include <bitcoin/node/block_pool.hpp>
 #include <bitcoin/node/define.hpp>
 
 namespace libbitcoin {
@@ -29,22 +31,52 @@ using namespace system;
 // construct/destruct/assign
 // ----------------------------------------------------------------------------
 
-block_arena::block_arena(size_t multiple) NOEXCEPT
-  : memory_map_{ nullptr },
+block_arena::block_arena(size_t multiple, size_t retain, size_t huge,
+    size_t node) NOEXCEPT
+  : pool_{ retain, huge, node },
+    memory_map_{ nullptr },
     multiple_{ multiple },
     offset_{ zero },
     total_{ zero },
-    size_{ zero }
+    size_{ zero },
+    wire_size_{ zero },
+    links_{ zero },
+    objects_{ zero },
+    padding_{ zero },
+    samples_{},
+    estimates_{},
+    blocks_{ zero },
+    chunks_{ zero },
+    allocations_{ zero },
+    bytes_{ zero },
+    padded_{ zero }
 {
+    for (auto& ratio : ratios_)
+        ratio.store(to_floating(multiple_));
 }
 
 block_arena::block_arena(block_arena&& other) NOEXCEPT
-  : memory_map_{ other.memory_map_ },
+  : pool_{ std::move(other.pool_) },
+    memory_map_{ other.memory_map_ },
     multiple_{ other.multiple_ },
     offset_{ other.offset_ },
     total_{ other.total_ },
-    size_{ other.size_ }
+    size_{ other.size_ },
+    wire_size_{ other.wire_size_ },
+    links_{ other.links_ },
+    objects_{ other.objects_ },
+    padding_{ other.padding_ },
+    samples_{ other.samples_ },
+    estimates_{ other.estimates_ },
+    blocks_{ other.blocks_.load() },
+    chunks_{ other.chunks_.load() },
+    allocations_{ other.allocations_.load() },
+    bytes_{ other.bytes_.load() },
+    padded_{ other.padded_.load() }
 {
+    for (size_t band = zero; band < bands; ++band)
+        ratios_.at(band).store(other.ratios_.at(band).load());
+
     // Prevents free(memory_map_) as responsibility is passed to this object.
     other.memory_map_ = nullptr;
 }
@@ -55,11 +87,26 @@ block_arena::~block_arena() NOEXCEPT
 
 block_arena& block_arena::operator=(block_arena&& other) NOEXCEPT
 {
+    pool_ = std::move(other.pool_);
     memory_map_ = other.memory_map_;
     multiple_ = other.multiple_;
     offset_ = other.offset_;
     total_ = other.total_;
     size_ = other.size_;
+    wire_size_ = other.wire_size_;
+    links_ = other.links_;
+    objects_ = other.objects_;
+    padding_ = other.padding_;
+    samples_ = other.samples_;
+    estimates_ = other.estimates_;
+    blocks_.store(other.blocks_.load());
+    chunks_.store(other.chunks_.load());
+    allocations_.store(other.allocations_.load());
+    bytes_.store(other.bytes_.load());
+    padded_.store(other.padded_.load());
+
+    for (size_t band = zero; band < bands; ++band)
+        ratios_.at(band).store(other.ratios_.at(band).load());
 
     // Prevents free(memory_map_) as responsibility is passed to this object.
     other.memory_map_ = nullptr;
@@ -71,21 +118,26 @@ block_arena& block_arena::operator=(block_arena&& other) NOEXCEPT
 
 void* block_arena::start(size_t wire_size) THROWS
 {
-    if (is_multiply_overflow(wire_size, multiple_))
-        throw allocation_exception{};
-
-    size_ = wire_size * multiple_;
+    size_ = first_size(wire_size);
+    wire_size_ = wire_size;
     memory_map_ = nullptr;
     offset_ = zero;
     total_ = zero;
+    links_ = zero;
+    objects_ = zero;
+    padding_ = zero;
     push();
     return memory_map_;
 }
 
 size_t block_arena::detach() NOEXCEPT
 {
+    const auto allocated = total_ + offset_;
+    learn(allocated);
+
     memory_map_ = nullptr;
-    return total_ + offset_;
+    wire_size_ = zero;
+    return allocated;
 }
 
 void block_arena::release(void* address) NOEXCEPT
@@ -98,9 +150,106 @@ void block_arena::release(void* address) NOEXCEPT
     }
 }
 
+const block_pool& block_arena::pool() const NOEXCEPT
+{
+    return pool_;
+}
+
+double block_arena::ratio(size_t wire_size) const NOEXCEPT
+{
+    return ratios_.at(to_band(wire_size)).load(std::memory_order_relaxed);
+}
+
+double block_arena::chain() const NOEXCEPT
+{
+    const auto blocks = blocks_.load(std::memory_order_relaxed);
+    const auto chunks = chunks_.load(std::memory_order_relaxed);
+    return is_zero(blocks) ? 0.0 : to_floating(chunks) / blocks;
+}
+
+size_t block_arena::blocks() const NOEXCEPT
+{
+    return blocks_.load(std::memory_order_relaxed);
+}
+
+size_t block_arena::chunks() const NOEXCEPT
+{
+    return chunks_.load(std::memory_order_relaxed);
+}
+
+size_t block_arena::objects() const NOEXCEPT
+{
+    return allocations_.load(std::memory_order_relaxed);
+}
+
+size_t block_arena::bytes() const NOEXCEPT
+{
+    return bytes_.load(std::memory_order_relaxed);
+}
+
+size_t block_arena::padding() const NOEXCEPT
+{
+    return padded_.load(std::memory_order_relaxed);
+}
+
 // protected
 // ----------------------------------------------------------------------------
 
+size_t block_arena::first_size(size_t wire_size) const THROWS
+{
+    // The configured multiple applies until the band has been warmed up.
+    const auto band = to_band(wire_size);
+    if (samples_.at(band) < warmup)
+    {
+        if (is_multiply_overflow(wire_size, multiple_))
+            throw allocation_exception{};
+
+        return wire_size * multiple_;
+    }
+
+    const auto size = estimates_.at(band) * to_floating(wire_size);
+    if (size >= to_floating(max_size_t))
+        throw allocation_exception{};
+
+    return to_ceilinged_integer<size_t>(size);
+}
+
+void block_arena::learn(size_t allocated) NOEXCEPT
+{
+    if (is_zero(wire_size_))
+        return;
+
+    const auto band = to_band(wire_size_);
+    const auto sample = to_floating(allocated) / wire_size_;
+    auto& estimate = estimates_.at(band);
+    auto& samples = samples_.at(band);
+
+    // Stochastic quantile estimate, converges where P(ratio > estimate) is
+    // (1 - quantile), so that most allocations fit within the first chunk.
+    if (is_zero(samples))
+    {
+        estimate = sample;
+    }
+    else
+    {
+        const auto step = rate * estimate;
+        estimate += sample > estimate ? step * quantile :
+            -step * (1.0 - quantile);
+    }
+
+    if (samples < warmup)
+        ++samples;
+
+    if (samples == warmup)
+        ratios_.at(band).store(estimate, std::memory_order_relaxed);
+
+    blocks_.fetch_add(one, std::memory_order_relaxed);
+    chunks_.fetch_add(links_, std::memory_order_relaxed);
+    allocations_.fetch_add(objects_, std::memory_order_relaxed);
+    bytes_.fetch_add(allocated, std::memory_order_relaxed);
+    padded_.fetch_add(padding_, std::memory_order_relaxed);
+}
+
 void block_arena::push(size_t minimum) THROWS
 {
     static constexpr size_t link_size = sizeof(void*);
@@ -121,6 +270,7 @@ void block_arena::push(size_t minimum) THROWS
     set_link(nullptr);
     total_ += offset_;
     offset_ = link_size;
+    ++links_;
 }
 
 // protected interface
@@ -142,6 +292,8 @@ void* block_arena::do_allocate(size_t bytes, size_t align) THROWS
     }
     else
     {
+        ++objects_;
+        padding_ += padding;
         offset_ += allocation;
 
         BC_PUSH_WARNING(NO_POINTER_ARITHMETIC)
@@ -18,28 +18,288 @@
  */
 #include <bitcoin/node/block_memory.hpp>
 
+#include <algorithm>
 #include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
 #include <bitcoin/node/define.hpp>
 
 namespace libbitcoin {
 namespace node {
 
+using namespace system;
+
 BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
 
-block_memory::block_memory(size_t multiple, size_t threads) NOEXCEPT
+// Slots are keyed by instance identity, as addresses may be reused.
+struct block_memory::slots
 {
-    if (is_nonzero(multiple))
+    struct slot
+    {
+        size_t identity;
+        std::weak_ptr<registry> owner;
+        size_t index;
+        block_arena* instance;
+    };
+
+    ~slots() NOEXCEPT
     {
-        arenas_.reserve(threads);
-        for (auto index = zero; index < threads; ++index)
-            arenas_.emplace_back(multiple);
+        // Return each slot to its registry if the registry still exists.
+        for (const auto& item : items)
+        {
+            if (const auto owner = item.owner.lock())
+            {
+                std::unique_lock lock{ owner->mutex };
+                owner->free.push_back(item.index);
+            }
+        }
     }
+
+    std::vector<slot> items{};
+};
+
+static std::atomic_size_t identities{ zero };
+
+block_memory::block_memory(size_t multiple, size_t threads, size_t retain,
+    size_t huge, bool per_node) NOEXCEPT
+  : multiple_{ multiple },
+    retain_{ retain },
+    huge_{ huge },
+    identity_{ identities.fetch_add(one, std::memory_order_relaxed) },
+    registries_{ [&]() NOEXCEPT
+    {
+        const auto count = per_node ? numa::nodes() : one;
+        registries out{};
+        out.reserve(count);
+        for (auto node = zero; node < count; ++node)
+            out.push_back(std::make_shared<registry>(per_node ? node :
+                numa::unbound));
+
+        if (is_nonzero(multiple))
+        {
+            // Initial arenas are distributed evenly across nodes.
+            for (auto index = zero; index < threads; ++index)
+            {
+                auto& item = *out.at(index % count);
+                item.free.push_back(item.arenas.size());
+                item.arenas.emplace_back(multiple, retain, huge, item.node);
+            }
+
+            // Assign lowest slots first.
+            for (auto& item : out)
+                std::reverse(item->free.begin(), item->free.end());
+        }
+
+        return out;
+    }() }
+{
 }
 
 arena* block_memory::get_arena() NOEXCEPT
 {
-    thread_local auto thread = count_.fetch_add(one, std::memory_order_relaxed);
-    return thread < arenas_.size() ? &arenas_.at(thread) : default_arena::get();
+    if (is_zero(multiple_))
+        return default_arena::get();
+
+    thread_local slots local{};
+    for (const auto& item : local.items)
+        if (item.identity == identity_)
+            return item.instance;
+
+    return assign(local);
+}
+
+bool block_memory::enabled() const NOEXCEPT
+{
+    return is_nonzero(multiple_);
+}
+
+// The block is destructed before its chunks are released. Arena deallocation
+// is a nop, but objects attached after deserialization (such as populated
+// prevouts and their metadata, and connect caches) are not arena allocated.
+chain::block::cptr block_memory::deserialize(const data_chunk& data,
+    bool witness) NOEXCEPT
+{
+    const auto memory = get_arena();
+    if (memory == default_arena::get())
+    {
+        const auto block = std::make_shared<const chain::block>(data, witness);
+        return block->is_valid() ? block : nullptr;
+    }
+
+    if (data.empty())
+        return {};
+
+    const auto first = memory->start(data.size());
+    stream::in::fast source{ data };
+    read::bytes::fast reader{ source, memory };
+
+    BC_PUSH_WARNING(NO_NEW_OR_DELETE)
+    const auto block = new (memory->allocate(sizeof(chain::block),
+        alignof(chain::block))) chain::block{ reader, witness };
+    BC_POP_WARNING()
+
+    memory->detach();
+    if (!reader)
+    {
+        block->~block();
+        memory->release(first);
+        return {};
+    }
+
+    return { block, [memory, first](const chain::block* ptr) NOEXCEPT
+    {
+        ptr->~block();
+        memory->release(first);
+    } };
+}
+
+size_t block_memory::assignments() const NOEXCEPT
+{
+    return assignments_.load(std::memory_order_relaxed);
+}
+
+size_t block_memory::fallbacks() const NOEXCEPT
+{
+    return fallbacks_.load(std::memory_order_relaxed);
+}
+
+size_t block_memory::hits() const NOEXCEPT
+{
+    return sum([](const block_arena& item) NOEXCEPT
+    {
+        return item.pool().hits();
+    });
+}
+
+size_t block_memory::misses() const NOEXCEPT
+{
+    return sum([](const block_arena& item) NOEXCEPT
+    {
+        return item.pool().misses();
+    });
+}
+
+size_t block_memory::mapped() const NOEXCEPT
+{
+    return sum([](const block_arena& item) NOEXCEPT
+    {
+        return item.pool().mapped();
+    });
+}
+
+size_t block_memory::blocks() const NOEXCEPT
+{
+    return sum([](const block_arena& item) NOEXCEPT
+    {
+        return item.blocks();
+    });
+}
+
+size_t block_memory::chunks() const NOEXCEPT
+{
+    return sum([](const block_arena& item) NOEXCEPT
+    {
+        return item.chunks();
+    });
+}
+
+size_t block_memory::objects() const NOEXCEPT
+{
+    return sum([](const block_arena& item) NOEXCEPT
+    {
+        return item.objects();
+    });
+}
+
+size_t block_memory::bytes() const NOEXCEPT
+{
+    return sum([](const block_arena& item) NOEXCEPT
+    {
+        return item.bytes();
+    });
+}
+
+size_t block_memory::padding() const NOEXCEPT
+{
+    return sum([](const block_arena& item) NOEXCEPT
+    {
+        return item.padding();
+    });
+}
+
+size_t block_memory::live() const NOEXCEPT
+{
+    return sum([](const block_arena& item) NOEXCEPT
+    {
+        return item.pool().live();
+    });
+}
+
+size_t block_memory::peak() const NOEXCEPT
+{
+    return sum([](const block_arena& item) NOEXCEPT
+    {
+        return item.pool().peak();
+    });
+}
+
+size_t block_memory::nodes() const NOEXCEPT
+{
+    return registries_.size();
+}
+
+// protected
+// ----------------------------------------------------------------------------
+
+template <typename Statistic>
+size_t block_memory::sum(const Statistic& statistic) const NOEXCEPT
+{
+    auto total = zero;
+    for (const auto& registry : registries_)
+    {
+        std::unique_lock lock{ registry->mutex };
+        for (const auto& item : registry->arenas)
+            total = ceilinged_add(total, statistic(item));
+    }
+
+    return total;
+}
+
+block_arena* block_memory::assign(slots& local) NOEXCEPT
+{
+    // Drop slots of destroyed instances held by this thread.
+    std::erase_if(local.items, [](const auto& item) NOEXCEPT
+    {
+        return item.owner.expired();
+    });
+
+    // A thread remains assigned to the node on which it first allocates.
+    const auto& registry = is_one(nodes()) ? registries_.front() :
+        registries_.at(numa::node() % nodes());
+
+    std::unique_lock lock{ registry->mutex };
+    auto& free = registry->free;
+    auto& arenas = registry->arenas;
+    size_t index{};
+
+    if (free.empty())
+    {
+        // Deque growth does not invalidate references to existing arenas.
+        index = arenas.size();
+        arenas.emplace_back(multiple_, retain_, huge_, registry->node);
+        fallbacks_.fetch_add(one, std::memory_order_relaxed);
+    }
+    else
+    {
+        index = free.back();
+        free.pop_back();
+    }
+
+    const auto instance = &arenas.at(index);
+    local.items.push_back({ identity_, registry, index, instance });
+    assignments_.fetch_add(one, std::memory_order_relaxed);
+    return instance;
 }
 
 BC_POP_WARNING()
@@ -0,0 +1,361 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/block_pool.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <bitcoin/node/define.hpp>
+
+#if !defined(HAVE_MSC)
+    #include <sys/mman.h>
+#endif
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_POINTER_ARITHMETIC)
+BC_PUSH_WARNING(NO_ARRAY_INDEXING)
+
+// construct/destruct/assign
+// ----------------------------------------------------------------------------
+
+// A chunk below the huge page size would be rounded up to a full huge page.
+block_pool::block_pool(size_t retain, size_t huge, size_t node) NOEXCEPT
+  : retain_{ retain },
+    huge_{ is_zero(huge) ? zero : std::max(huge, huge_page) },
+    node_{ node }
+{
+}
+
+// Move is not thread safe, source must be quiescent (construction only).
+block_pool::block_pool(block_pool&& other) NOEXCEPT
+  : retain_{ other.retain_ },
+    huge_{ other.huge_ },
+    node_{ other.node_ },
+    owner_{ other.owner_.load() },
+    returned_{ other.returned_.exchange(nullptr) },
+    retained_{ other.retained_.exchange(zero) },
+    hits_{ other.hits_.load() },
+    misses_{ other.misses_.load() },
+    mapped_{ other.mapped_.load() },
+    live_{ other.live_.load() },
+    peak_{ other.peak_.load() },
+    free_list_{ other.free_list_ }
+{
+    // Prevents free of chunks as responsibility is passed to this object.
+    other.free_list_.fill(nullptr);
+}
+
+block_pool::~block_pool() NOEXCEPT
+{
+    clear();
+}
+
+block_pool& block_pool::operator=(block_pool&& other) NOEXCEPT
+{
+    clear();
+    retain_ = other.retain_;
+    huge_ = other.huge_;
+    node_ = other.node_;
+    owner_.store(other.owner_.load());
+    returned_.store(other.returned_.exchange(nullptr));
+    retained_.store(other.retained_.exchange(zero));
+    hits_.store(other.hits_.load());
+    misses_.store(other.misses_.load());
+    mapped_.store(other.mapped_.load());
+    live_.store(other.live_.load());
+    peak_.store(other.peak_.load());
+    free_list_ = other.free_list_;
+
+    // Prevents free of chunks as responsibility is passed to this object.
+    other.free_list_.fill(nullptr);
+    return *this;
+}
+
+// public
+// ----------------------------------------------------------------------------
+
+void* block_pool::allocate(size_t bytes) NOEXCEPT
+{
+    // The allocating thread becomes the owner of the local free lists.
+    owner_.store(std::this_thread::get_id(), std::memory_order_relaxed);
+
+    // Take ownership of chunks returned by other threads.
+    if (!is_null(returned_.load(std::memory_order_relaxed)))
+        reclaim();
+
+    const auto index = to_class(bytes);
+    if (index != unclassed)
+    {
+        if (const auto item = free_list_[index]; !is_null(item))
+        {
+            free_list_[index] = item->next;
+            retained_.fetch_sub(to_size(index), std::memory_order_relaxed);
+            hits_.fetch_add(one, std::memory_order_relaxed);
+            add_live(item->bytes);
+            return std::next(item);
+        }
+    }
+
+    // Unclassed chunks are sized to the request and never recycled.
+    const auto size = index == unclassed ? bytes : to_size(index);
+    if (is_add_overflow(size, sizeof(chunk)))
+        return nullptr;
+
+    const auto item = acquire(size + sizeof(chunk));
+    if (is_null(item))
+        return nullptr;
+
+    misses_.fetch_add(one, std::memory_order_relaxed);
+    add_live(item->bytes);
+    item->next = nullptr;
+    item->index = index;
+    return std::next(item);
+}
+
+void block_pool::deallocate(void* address) NOEXCEPT
+{
+    if (is_null(address))
+        return;
+
+    const auto item = std::prev(pointer_cast<chunk>(address));
+    live_.fetch_sub(item->bytes, std::memory_order_relaxed);
+
+    if (is_owner())
+    {
+        recycle(item);
+        return;
+    }
+
+    // Lock-free push onto the return stack (drained in whole by owner).
+    auto head = returned_.load(std::memory_order_relaxed);
+    do
+    {
+        item->next = head;
+    } while (!returned_.compare_exchange_weak(head, item,
+        std::memory_order_release, std::memory_order_relaxed));
+}
+
+size_t block_pool::hits() const NOEXCEPT
+{
+    return hits_.load(std::memory_order_relaxed);
+}
+
+size_t block_pool::misses() const NOEXCEPT
+{
+    return misses_.load(std::memory_order_relaxed);
+}
+
+size_t block_pool::retained() const NOEXCEPT
+{
+    return retained_.load(std::memory_order_relaxed);
+}
+
+size_t block_pool::mapped() const NOEXCEPT
+{
+    return mapped_.load(std::memory_order_relaxed);
+}
+
+size_t block_pool::live() const NOEXCEPT
+{
+    return live_.load(std::memory_order_relaxed);
+}
+
+size_t block_pool::peak() const NOEXCEPT
+{
+    return peak_.load(std::memory_order_relaxed);
+}
+
+size_t block_pool::node() const NOEXCEPT
+{
+    return node_;
+}
+
+// protected
+// ----------------------------------------------------------------------------
+
+void* block_pool::map_(size_t bytes, bool huge) NOEXCEPT
+{
+#if defined(HAVE_MSC)
+    // Large pages require SeLockMemoryPrivilege, use the system allocator.
+    return nullptr;
+#else
+    constexpr auto protection = PROT_READ | PROT_WRITE;
+    constexpr auto flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+#if defined(MAP_HUGETLB)
+    // Explicit huge pages are available only if reserved (vm.nr_hugepages).
+    if (huge)
+    {
+        if (const auto map = ::mmap(nullptr, bytes, protection,
+            flags | MAP_HUGETLB, -1, 0); map != MAP_FAILED)
+            return map;
+    }
+#endif
+
+    const auto map = ::mmap(nullptr, bytes, protection, flags, -1, 0);
+    if (map == MAP_FAILED)
+        return nullptr;
+
+#if defined(MADV_HUGEPAGE)
+    // Transparent huge pages are advisory, ignored if disabled.
+    if (huge)
+        ::madvise(map, bytes, MADV_HUGEPAGE);
+#endif
+
+    return map;
+#endif
+}
+
+void block_pool::unmap_(void* address, size_t bytes) NOEXCEPT
+{
+#if defined(HAVE_MSC)
+    // Unreachable, map_ does not map.
+    free_(address);
+#else
+    ::munmap(address, bytes);
+#endif
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+// Huge page mapping is attempted for chunks at or above the threshold.
+// Node binding is applied before the chunk header is written (first touch).
+block_pool::chunk* block_pool::acquire(size_t bytes) NOEXCEPT
+{
+    const auto huge = is_nonzero(huge_) && bytes >= huge_;
+    const auto bound = node_ != numa::unbound && bytes >= page;
+    const auto align = huge ? huge_page : page;
+
+    if ((huge || bound) && bytes <= max_size_t - align)
+    {
+        const auto length = (bytes + sub1(align)) & ~sub1(align);
+        if (const auto map = pointer_cast<chunk>(map_(length, huge));
+            !is_null(map))
+        {
+            if (bound)
+                numa::bind(map, length, node_);
+
+            mapped_.fetch_add(one, std::memory_order_relaxed);
+            map->bytes = length;
+            map->mapped = true;
+            return map;
+        }
+    }
+
+    const auto item = pointer_cast<chunk>(malloc_(bytes));
+    if (is_null(item))
+        return nullptr;
+
+    item->bytes = bytes;
+    item->mapped = false;
+    return item;
+}
+
+void block_pool::dispose(chunk* item) NOEXCEPT
+{
+    if (item->mapped)
+        unmap_(item, item->bytes);
+    else
+        free_(item);
+}
+
+bool block_pool::is_owner() const NOEXCEPT
+{
+    return owner_.load(std::memory_order_relaxed) == std::this_thread::get_id();
+}
+
+// The whole stack is taken at once, so there is no ABA exposure.
+void block_pool::reclaim() NOEXCEPT
+{
+    auto item = returned_.exchange(nullptr, std::memory_order_acquire);
+    while (!is_null(item))
+    {
+        const auto next = item->next;
+        recycle(item);
+        item = next;
+    }
+}
+
+void block_pool::recycle(chunk* item) NOEXCEPT
+{
+    const auto index = item->index;
+    if (index == unclassed)
+    {
+        dispose(item);
+        return;
+    }
+
+    const auto size = to_size(index);
+    const auto retained = retained_.load(std::memory_order_relaxed);
+    if (is_add_overflow(retained, size) || (retained + size > retain_))
+    {
+        dispose(item);
+        return;
+    }
+
+    item->next = free_list_[index];
+    free_list_[index] = item;
+    retained_.fetch_add(size, std::memory_order_relaxed);
+}
+
+void block_pool::clear() NOEXCEPT
+{
+    for (auto& head : free_list_)
+    {
+        while (!is_null(head))
+        {
+            const auto next = head->next;
+            dispose(head);
+            head = next;
+        }
+    }
+
+    auto item = returned_.exchange(nullptr, std::memory_order_acquire);
+    while (!is_null(item))
+    {
+        const auto next = item->next;
+        dispose(item);
+        item = next;
+    }
+
+    retained_.store(zero, std::memory_order_relaxed);
+}
+
+void block_pool::add_live(size_t bytes) NOEXCEPT
+{
+    const auto live = live_.fetch_add(bytes, std::memory_order_relaxed) +
+        bytes;
+
+    // Peak is raised by whichever thread observes the higher value.
+    auto peak = peak_.load(std::memory_order_relaxed);
+    while (live > peak)
+        if (peak_.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+            return;
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
@@ -0,0 +1,174 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/candidate_window.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+#include <shared_mutex>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+candidate_window::candidate_window(size_t limit) NOEXCEPT
+  : limit_{ limit }
+{
+}
+
+candidate_window::~candidate_window() NOEXCEPT
+{
+}
+
+void candidate_window::set(size_t height, const database::header_link& link,
+    state value) NOEXCEPT
+{
+    if (link.is_terminal() || value == state::unknown)
+        return;
+
+    std::unique_lock lock{ mutex_ };
+    set_(height, link.value, value);
+}
+
+bool candidate_window::claim(size_t height,
+    const database::header_link& link, state value) NOEXCEPT
+{
+    if (link.is_terminal() || value == state::unknown)
+        return true;
+
+    std::unique_lock lock{ mutex_ };
+    if (height < floor_ || get_(height, link.value) != state::unknown)
+        return false;
+
+    if ((height - floor_) >= limit_)
+        return true;
+
+    set_(height, link.value, value);
+    return true;
+}
+
+void candidate_window::unclaim(size_t height,
+    const database::header_link& link) NOEXCEPT
+{
+    std::unique_lock lock{ mutex_ };
+    if (get_(height, link.value) != state::claimed)
+        return;
+
+    records_.at(height - floor_) = { database::header_link::terminal,
+        state::unknown };
+}
+
+candidate_window::state candidate_window::get(size_t height,
+    const database::header_link& link) const NOEXCEPT
+{
+    std::shared_lock lock{ mutex_ };
+    return get_(height, link.value);
+}
+
+bool candidate_window::is_associated(size_t height,
+    const database::header_link& link) const NOEXCEPT
+{
+    return get(height, link) >= state::associated;
+}
+
+void candidate_window::regress(size_t branch_point) NOEXCEPT
+{
+    std::unique_lock lock{ mutex_ };
+    if (branch_point < floor_)
+    {
+        records_.clear();
+        floor_ = add1(branch_point);
+        return;
+    }
+
+    const auto count = add1(branch_point - floor_);
+    if (count < records_.size())
+        records_.resize(count);
+}
+
+void candidate_window::advance(size_t height) NOEXCEPT
+{
+    std::unique_lock lock{ mutex_ };
+    if (height <= floor_)
+        return;
+
+    const auto count = std::min(height - floor_, records_.size());
+    records_.erase(records_.begin(), std::next(records_.begin(), count));
+    floor_ = height;
+}
+
+size_t candidate_window::floor() const NOEXCEPT
+{
+    std::shared_lock lock{ mutex_ };
+    return floor_;
+}
+
+size_t candidate_window::size() const NOEXCEPT
+{
+    std::shared_lock lock{ mutex_ };
+    return records_.size();
+}
+
+// private (must be locked)
+// ----------------------------------------------------------------------------
+
+candidate_window::state candidate_window::get_(size_t height,
+    const header_t& link) const NOEXCEPT
+{
+    if (height < floor_ || (height - floor_) >= records_.size())
+        return state::unknown;
+
+    const auto& entry = records_.at(height - floor_);
+    return entry.link == link ? entry.value : state::unknown;
+}
+
+// Heights above the window are filled as unknown up to the limit, heights
+// below the window or at the limit are ignored. The floor is set only by
+// advance and regress, as records arrive out of order (the first record is
+// not generally the lowest).
+void candidate_window::set_(size_t height, const header_t& link,
+    state value) NOEXCEPT
+{
+    if (height < floor_ || (height - floor_) >= limit_)
+        return;
+
+    const auto index = height - floor_;
+    if (index >= records_.size())
+        records_.resize(add1(index), { database::header_link::terminal,
+            state::unknown });
+
+    auto& entry = records_.at(index);
+    if (entry.link != link)
+    {
+        entry = { link, value };
+        return;
+    }
+
+    if (value > entry.value)
+        entry.value = value;
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
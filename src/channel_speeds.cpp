@@ -0,0 +1,196 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/channel_speeds.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+channel_speeds::channel_speeds(double smoothing) NOEXCEPT
+  : smoothing_(smoothing > 0.0 && smoothing < 1.0 ? smoothing : 1.0)
+{
+}
+
+// The previous contribution of the channel is replaced by its new smoothed
+// speed, so that each update is independent of the number of channels.
+double channel_speeds::update(object_key channel, double speed) NOEXCEPT
+{
+    const auto [it, inserted] = speeds_.try_emplace(channel, speed);
+    if (inserted)
+    {
+        ordered_ = false;
+    }
+    else
+    {
+        const auto prior = it->second;
+        it->second = (smoothing_ * speed) + ((1.0 - smoothing_) * prior);
+        sum_ -= prior;
+        squares_ -= prior * prior;
+    }
+
+    sum_ += it->second;
+    squares_ += it->second * it->second;
+
+    if (++updates_ >= speeds_.size())
+        refresh();
+
+    return it->second;
+}
+
+bool channel_speeds::erase(object_key channel) NOEXCEPT
+{
+    const auto it = speeds_.find(channel);
+    if (it == speeds_.end())
+        return false;
+
+    sum_ -= it->second;
+    squares_ -= it->second * it->second;
+    speeds_.erase(it);
+    ordered_ = false;
+
+    if (speeds_.empty())
+        refresh();
+
+    return true;
+}
+
+bool channel_speeds::slowest(object_key& channel) const NOEXCEPT
+{
+    const auto it = std::min_element(speeds_.begin(), speeds_.end(),
+        [](const auto& left, const auto& right) NOEXCEPT
+        {
+            return left.second < right.second;
+        });
+
+    if (it == speeds_.end())
+        return false;
+
+    channel = it->first;
+    return true;
+}
+
+double channel_speeds::speed(object_key channel) const NOEXCEPT
+{
+    const auto it = speeds_.find(channel);
+    return it == speeds_.end() ? 0.0 : it->second;
+}
+
+size_t channel_speeds::size() const NOEXCEPT
+{
+    return speeds_.size();
+}
+
+// statistics
+// ----------------------------------------------------------------------------
+
+double channel_speeds::sum() const NOEXCEPT
+{
+    return sum_;
+}
+
+double channel_speeds::mean() const NOEXCEPT
+{
+    return speeds_.empty() ? 0.0 : sum_ / speeds_.size();
+}
+
+// Sample variance (Bessel's correction), clamped against negative drift.
+double channel_speeds::variance() const NOEXCEPT
+{
+    const auto count = speeds_.size();
+    if (count < two)
+        return 0.0;
+
+    const auto value = (squares_ - (sum_ * sum_) / count) / sub1(count);
+    return std::max(value, 0.0);
+}
+
+double channel_speeds::deviation() const NOEXCEPT
+{
+    return std::sqrt(variance());
+}
+
+double channel_speeds::median() NOEXCEPT
+{
+    order();
+    return median_;
+}
+
+double channel_speeds::mad() NOEXCEPT
+{
+    order();
+    return mad_;
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+void channel_speeds::refresh() NOEXCEPT
+{
+    sum_ = 0.0;
+    squares_ = 0.0;
+    for (const auto& element : speeds_)
+    {
+        sum_ += element.second;
+        squares_ += element.second * element.second;
+    }
+
+    updates_ = zero;
+    ordered_ = false;
+}
+
+// Ordering is retained until membership changes or the round completes.
+// Upper median for an even count, sufficient for outlier detection.
+void channel_speeds::order() NOEXCEPT
+{
+    if (ordered_)
+        return;
+
+    ordered_ = true;
+    if (speeds_.empty())
+    {
+        median_ = mad_ = 0.0;
+        return;
+    }
+
+    scratch_.clear();
+    for (const auto& element : speeds_)
+        scratch_.push_back(element.second);
+
+    const auto middle = std::next(scratch_.begin(), to_half(scratch_.size()));
+    std::nth_element(scratch_.begin(), middle, scratch_.end());
+    median_ = *middle;
+
+    for (auto& value : scratch_)
+        value = std::abs(value - median_);
+
+    std::nth_element(scratch_.begin(), middle, scratch_.end());
+    mad_ = *middle;
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
@@ -126,6 +126,11 @@ query& chaser::archive() const NOEXCEPT
     return node_.archive();
 }
 
+candidate_window& chaser::candidates() const NOEXCEPT
+{
+    return node_.candidates();
+}
+
 const node::configuration& chaser::node_config() const NOEXCEPT
 {
     return node_.node_config();
@@ -172,6 +177,11 @@ bool chaser::is_recent() const NOEXCEPT
     return node_.is_recent();
 }
 
+size_t chaser::channel_count() const NOEXCEPT
+{
+    return node_.channel_count();
+}
+
 bool chaser::is_under_checkpoint(size_t height) const NOEXCEPT
 {
     return height <= checkpoint();
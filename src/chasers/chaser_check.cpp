@@ -19,7 +19,7 @@
 #include <bitcoin/node/chasers/chaser_check.hpp>
 
 #include <algorithm>
-#include <cmath>
+#include <array>
 #include <memory>
 #include <ratio>
 #include <bitcoin/node/chasers/chaser.hpp>
@@ -62,10 +62,17 @@ size_t get_step(size_t connections, size_t maximum_concurrency) NOEXCEPT
 chaser_check::chaser_check(full_node& node) NOEXCEPT
   : chaser(node),
     allowed_deviation_(node.node_settings().allowed_deviation),
+    median_deviation_(node.node_settings().median_deviation),
     maximum_concurrency_(node.node_settings().maximum_concurrency_()),
     maximum_height_(node.node_settings().maximum_height_()),
     connections_(get_target_connections(node.network_settings())),
-    step_(get_step(connections_, maximum_concurrency_))
+    modeled_(is_modeled(node.system_settings())),
+    map_bytes_(possible_narrow_cast<size_t>(
+        node.node_settings().download_map_bytes)),
+    lookahead_bytes_(possible_narrow_cast<size_t>(
+        node.node_settings().lookahead_bytes)),
+    step_(get_step(connections_, maximum_concurrency_)),
+    speeds_(node.node_settings().speed_smoothing)
 {
 }
 
@@ -78,11 +85,54 @@ map_ptr chaser_check::empty_map() NOEXCEPT
 // static
 map_ptr chaser_check::split(const map_ptr& map) NOEXCEPT
 {
-    const auto half = empty_map();
+    return take(map, to_half(map->size()));
+}
+
+// static
+map_ptr chaser_check::take(const map_ptr& map, size_t count) NOEXCEPT
+{
+    const auto part = empty_map();
     auto& index = map->get<association::pos>();
-    const auto end = std::next(index.begin(), to_half(map->size()));
-    half->merge(index, index.begin(), end);
-    return half;
+    const auto end = std::next(index.begin(), std::min(count, map->size()));
+    part->merge(index, index.begin(), end);
+    return part;
+}
+
+// static
+size_t chaser_check::revoke(const map_ptr& map, size_t branch_point) NOEXCEPT
+{
+    const auto size = map->size();
+    for (auto it = map->begin(); it != map->end();)
+        it = it->context.height > branch_point ? map->erase(it) : std::next(it);
+
+    return size - map->size();
+}
+
+// Mean serialized mainnet block size (rounded) by 50,000 block interval.
+constexpr size_t size_interval = 50'000;
+constexpr std::array<uint32_t, 17> block_sizes
+{
+    250, 600, 8'000, 60'000, 180'000, 300'000, 420'000, 720'000, 950'000,
+    1'000'000, 1'050'000, 1'100'000, 1'250'000, 1'300'000, 1'250'000,
+    1'600'000, 1'700'000
+};
+
+// static
+size_t chaser_check::estimate_block_size(size_t height) NOEXCEPT
+{
+    const auto index = std::min(height / size_interval,
+        sub1(block_sizes.size()));
+
+    return block_sizes.at(index);
+}
+
+// static
+bool chaser_check::is_modeled(const system::settings& settings) NOEXCEPT
+{
+    static const auto mainnet = system::settings{
+        system::chain::selection::mainnet }.genesis_block.hash();
+
+    return settings.genesis_block.hash() == mainnet;
 }
 
 // start/stop
@@ -93,7 +143,6 @@ map_ptr chaser_check::split(const map_ptr& map) NOEXCEPT
 // `advanced` tracks `requested` less window blocks not yet validated.
 code chaser_check::start() NOEXCEPT
 {
-    start_tracking();
     set_position(archive().get_fork());
     requested_ = advanced_ = position();
     const auto added = set_unassociated();
@@ -103,13 +152,6 @@ code chaser_check::start() NOEXCEPT
     return error::success;
 }
 
-void chaser_check::stopping(const code& ec) NOEXCEPT
-{
-    // Allow job completion as soon as all protocols are closed.
-    stop_tracking();
-    chaser::stopping(ec);
-}
-
 bool chaser_check::handle_chase(const code&, chase event_,
     event_value value) NOEXCEPT
 {
@@ -122,7 +164,7 @@ bool chaser_check::handle_chase(const code&, chase event_,
         // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
         case chase::starved:
         {
-            // When a channel becomes starved notify other(s) to split work.
+            // When a channel becomes starved notify other(s) to shed work.
             BC_ASSERT(std::holds_alternative<object_t>(value));
             POST(do_starved, std::get<object_t>(value));
             break;
@@ -177,42 +219,6 @@ bool chaser_check::handle_chase(const code&, chase event_,
     return true;
 }
 
-void chaser_check::start_tracking() NOEXCEPT
-{
-    // Called from start.
-    ////BC_ASSERT(stranded());
-
-    job_ = std::make_shared<job>(BIND(handle_purged, _1));
-}
-
-void chaser_check::stop_tracking() NOEXCEPT
-{
-    // Called by stop (node thread).
-    ////BC_ASSERT(stranded());
-
-    // shared_ptr.reset() is thread safe so can be called at stop.
-    // Resetting our own pointer allows destruct and call to handle_purged.
-    job_.reset();
-}
-
-void chaser_check::handle_purged(const code& ec) NOEXCEPT
-{
-    if (closed())
-        return;
-
-    boost::asio::post(strand(),
-        std::bind(&chaser_check::do_handle_purged,
-            this, ec));
-}
-
-void chaser_check::do_handle_purged(const code&) NOEXCEPT
-{
-    BC_ASSERT(stranded());
-
-    start_tracking();
-    do_bump({});
-}
-
 // starved
 // ----------------------------------------------------------------------------
 
@@ -220,25 +226,25 @@ void chaser_check::do_starved(object_t self) NOEXCEPT
 {
     BC_ASSERT(stranded());
 
+    // An idle channel above median speed may duplicate the window tail.
+    const auto fast = speeds_.speed(self) > speeds_.median();
+
     // Remove the starved channel to prevent self-selection.
-    if (speeds_.find(self) != speeds_.end())
-        speeds_.erase(self);
+    speeds_.erase(self);
 
-    // Find the slowest reporting channel.
-    const auto slowest = std::min_element(speeds_.begin(), speeds_.end(),
-        [](const auto& left, const auto& right) NOEXCEPT
-        {
-            return left.second < right.second;
-        });
+    // End-game, duplicate the few outstanding window blocks to this channel.
+    if (fast && set_endgame(self))
+        return;
 
-    // Direct the slowest channel to split work and stop.
-    if (slowest != speeds_.end())
+    // Direct the slowest reporting channel to shed unrequested work (not stop),
+    // or the upper half of its requested work if it has none unrequested.
+    object_key slow{};
+    if (speeds_.slowest(slow))
     {
-        // Erase entry so less likely to be claimed again before stopping.
-        const auto slow = slowest->first;
-        speeds_.erase(slowest);
+        // Erase entry so not claimed again until its next performance report.
+        speeds_.erase(slow);
 
-        // Notify slow channel to split itself (in favor of 'self' channel).
+        // Shed work is put to the pool and obtained by starved channel(s).
         notify_one(slow, error::success, chase::split, self);
         return;
     }
@@ -278,6 +284,7 @@ void chaser_check::do_update(object_key channel, uint64_t speed,
     if (speed == max_uint64)
     {
         speeds_.erase(channel);
+        strikes_.erase(channel);
         handler(error::exhausted_channel);
         return;
     }
@@ -286,13 +293,13 @@ void chaser_check::do_update(object_key channel, uint64_t speed,
     if (is_zero(speed))
     {
         speeds_.erase(channel);
+        strikes_.erase(channel);
         handler(error::stalled_channel);
         return;
     }
 
-    // Integer to floating point.
-    const auto fast = to_floating(speed);
-    speeds_[channel] = fast;
+    // Integer to floating point, smoothed (constant time in channel count).
+    const auto fast = speeds_.update(channel, to_floating(speed));
 
     // Three elements are required to measure deviation, don't drop below.
     const auto count = speeds_.size();
@@ -302,34 +309,35 @@ void chaser_check::do_update(object_key channel, uint64_t speed,
         return;
     }
 
-    double sum = 0.0;
-    double sum_squares = 0.0;
-    for (const auto& element : speeds_)
-    {
-        sum += element.second;
-        sum_squares += std::pow(element.second, two);
-    }
-
-    const auto mean = sum / count;
-    if (fast >= mean)
+    // Median/mad is robust to fast outliers inflating mean and deviation.
+    const auto center = median_deviation_ ? speeds_.median() : speeds_.mean();
+    if (fast >= center)
     {
+        strikes_.erase(channel);
         handler(error::success);
         return;
     }
 
-    const auto variance = (sum_squares - (sum * sum) / count) / sub1(count);
-    const auto sdev = std::sqrt(variance);
-    const auto slow = (mean - fast) > (allowed_deviation_ * sdev);
+    const auto sdev = median_deviation_ ?
+        channel_speeds::mad_scale * speeds_.mad() : speeds_.deviation();
+    const auto slow = (center - fast) > (allowed_deviation_ * sdev);
+
+    // Only persistently slow channels (consecutive reports) are dropped, as
+    // work is shed from slow channels without dropping them.
+    const auto strike = slow ? ++strikes_[channel] : zero;
+    if (!slow)
+        strikes_.erase(channel);
 
     // Only speed < mean channels are logged.
     LOGV("Below average channel (" << count << ") rate ("
-        << to_kilobits_per_second(sum)  << ") mean ("
-        << to_kilobits_per_second(mean) << ") sdev ("
+        << to_kilobits_per_second(speeds_.sum()) << ") center ("
+        << to_kilobits_per_second(center) << ") sdev ("
         << to_kilobits_per_second(sdev) << ") Kbps [" << (slow ? "*" : "")
-        << to_kilobits_per_second(fast) << "].");
+        << to_kilobits_per_second(fast) << "] strikes (" << strike << ").");
 
-    if (slow)
+    if (strike >= slow_strikes)
     {
+        strikes_.erase(channel);
         handler(error::slow_channel);
         return;
     }
@@ -348,25 +356,39 @@ void chaser_check::do_regressed(height_t branch_point) NOEXCEPT
     if (branch_point >= position())
         return;
 
-    // Update position, purge outstanding work, and wait on track completion.
+    // Only work above the branch point is revoked, from the pool and from
+    // channels, which retain the remainder and their connections. The window
+    // is reset to the branch point, so that the new branch is issued as its
+    // headers arrive (without waiting on channels to release all work).
     set_position(branch_point);
-    stop_tracking();
-    maps_.clear();
+    requested_ = std::min(requested_, branch_point);
+    advanced_ = std::min(advanced_, branch_point);
+    unassociated_ = zero;
+    inventory_ = zero;
+    const auto revoked = revoke_maps(branch_point);
     notify(error::success, chase::purge, branch_point);
+
+    LOGN("Regressed to (" << branch_point << ") revoked pooled ("
+        << revoked << ").");
 }
 
 // track downloaded in order (to move download window)
 // ----------------------------------------------------------------------------
 
-void chaser_check::do_advanced(height_t) NOEXCEPT
+void chaser_check::do_advanced(height_t height) NOEXCEPT
 {
     BC_ASSERT(stranded());
 
+    // Validations of the regressed branch may be posted after regression.
+    if (height > requested_)
+        return;
+
     // Validations are not ordered, so accumulate vs. compare height.
     ++advanced_;
 
-    // The full count of requested hashes has been validated.
-    if (advanced_ == requested_)
+    // The full count of requested hashes has been validated, or enough of it
+    // to look ahead into the next window.
+    if (advanced_ == requested_ || !is_zero(get_lookahead()))
         do_headers({});
 }
 
@@ -382,15 +404,13 @@ void chaser_check::do_checked(height_t height) NOEXCEPT
 void chaser_check::do_bump(height_t) NOEXCEPT
 {
     BC_ASSERT(stranded());
-    if (purging())
+    if (closed())
         return;
 
-    const auto& query = archive();
     auto height = position();
 
-    // TODO: query.is_associated() is expensive (hashmap search).
     // Skip checked blocks starting immediately after last checked.
-    while (!closed() && query.is_associated(query.to_candidate(++height)))
+    while (!closed() && is_associated(++height))
     {
         set_position(height);
 
@@ -416,11 +436,6 @@ void chaser_check::do_headers(height_t) NOEXCEPT
 // get/put hashes
 // ----------------------------------------------------------------------------
 
-bool chaser_check::purging() const NOEXCEPT
-{
-    return !job_;
-}
-
 void chaser_check::get_hashes(map_handler&& handler) NOEXCEPT
 {
     if (closed())
@@ -441,10 +456,10 @@ void chaser_check::put_hashes(const map_ptr& map,
 void chaser_check::do_get_hashes(const map_handler& handler) NOEXCEPT
 {
     BC_ASSERT(stranded());
-    if (closed() || purging())
+    if (closed())
         return;
 
-    handler(error::success, get_map(), job_);
+    handler(error::success, get_map());
 }
 
 void chaser_check::do_put_hashes(const map_ptr& map,
@@ -452,9 +467,12 @@ void chaser_check::do_put_hashes(const map_ptr& map,
 {
     BC_ASSERT(stranded());
     BC_ASSERT(map->size() <= messages::peer::max_inventory);
-    if (closed() || purging())
+    if (closed())
         return;
 
+    // Work is never issued above requested_, so anything above was revoked
+    // by a regression that raced this return.
+    revoke(map, requested_);
     if (set_map(map))
         notify(error::success, chase::download, map->size());
 
@@ -467,7 +485,12 @@ void chaser_check::do_put_hashes(const map_ptr& map,
 map_ptr chaser_check::get_map() NOEXCEPT
 {
     BC_ASSERT(stranded());
-    return maps_.empty() ? empty_map() : pop_front(maps_);
+    if (maps_.empty())
+        return empty_map();
+
+    const auto map = maps_.top().second;
+    maps_.pop();
+    return map;
 }
 
 bool chaser_check::set_map(const map_ptr& map) NOEXCEPT
@@ -478,7 +501,56 @@ bool chaser_check::set_map(const map_ptr& map) NOEXCEPT
     if (map->empty())
         return false;
 
-    maps_.push_back(map);
+    // Keyed on first height in position order (lowest for queried maps).
+    const auto& index = map->get<association::pos>();
+    maps_.emplace(index.begin()->context.height, map);
+    return true;
+}
+
+// Pooled maps are rekeyed, as the first height may be revoked.
+size_t chaser_check::revoke_maps(size_t branch_point) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    size_t count{};
+    auto pooled = std::move(maps_);
+    maps_ = {};
+    for (; !pooled.empty(); pooled.pop())
+    {
+        const auto& map = pooled.top().second;
+        count += revoke(map, branch_point);
+        set_map(map);
+    }
+
+    return count;
+}
+
+// When pooled work is exhausted and few blocks remain outstanding in the
+// window, one map of them (duplicating requests of other channels) is pooled
+// for the starved channel, which is notified to obtain it. Only one is pooled
+// for the outstanding tail at a given position, so another is pooled only
+// once the position advances. The first arrival is archived and late
+// arrivals dropped.
+bool chaser_check::set_endgame(object_key channel) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    if (closed() || !maps_.empty() || position() >= requested_ ||
+        (is_nonzero(endgames_) && position() == endgame_))
+        return false;
+
+    const auto map = std::make_shared<associations>(
+        archive().get_unassociated_above(position(), add1(endgame_blocks),
+            requested_));
+
+    if (map->size() > endgame_blocks || !set_map(map))
+        return false;
+
+    ++endgames_;
+    endgame_ = position();
+    LOGV("End-game (" << endgames_ << ") duplicated (" << map->size()
+        << ") above (" << position() << ") to (" << requested_ << ").");
+
+    notify_one(channel, error::success, chase::download, map->size());
     return true;
 }
 
@@ -489,18 +561,44 @@ size_t chaser_check::set_unassociated() NOEXCEPT
 {
     // Called from start.
     ////BC_ASSERT(stranded());
-    if (closed() || purging())
+    if (closed())
         return {};
 
     // Defer new work issuance until gaps filled.
     if (position() < requested_)
         return {};
 
-    // Defer new work until validation caught up to request.
-    if (advanced_ < requested_)
+    // Defer new work until validation caught up to request, unless within
+    // the lookahead budget of archived but unvalidated blocks.
+    const auto lookahead = get_lookahead();
+    if (advanced_ < requested_ && is_zero(lookahead))
         return {};
 
-    // Inventory size gets set only once.
+    // All pooled work (including end-game duplicates) is now archived.
+    if (!is_zero(endgames_))
+    {
+        LOGN("End-games (" << endgames_ << ") completed window ("
+            << requested_ << ").");
+        endgames_ = zero;
+        maps_ = {};
+    }
+
+    // Inventory size is reset when the number of channels changes.
+    const auto channels = channel_count();
+    if (const auto actual = is_zero(channels) ? connections_ : channels;
+        actual != channels_)
+    {
+        channels_ = actual;
+        inventory_ = zero;
+    }
+
+    // The unassociated count is refreshed once its range has been checked.
+    if (is_nonzero(unassociated_) && position() >= counted_)
+    {
+        unassociated_ = zero;
+        inventory_ = zero;
+    }
+
     if (is_zero(inventory_))
         if (is_zero((inventory_ = get_inventory_size())))
             return {};
@@ -512,14 +610,26 @@ size_t chaser_check::set_unassociated() NOEXCEPT
     const auto& query = archive();
     const auto previous = requested_;
     const auto step = ceilinged_add(position(), maximum_concurrency_);
-    const auto stop = std::min(step, maximum_height_);
+    auto stop = std::min(step, maximum_height_);
+    if (!is_zero(lookahead))
+        stop = std::min(stop, ceilinged_add(requested_, lookahead));
+
     size_t count{};
 
     while (true)
     {
-        // Calls query.is_associated() per block, expensive (hashmap search).
+        // Skip recorded associations, the query probes association per block.
+        // The query remains the source of unassociated hashes and contexts,
+        // which are not recorded in the window. Each skipped height is
+        // confirmed against its candidate link (an index read, not a probe),
+        // as a racing write can record a reorganized link above the floor.
+        auto start = requested_;
+        while (start < stop && is_recorded(add1(start)))
+            ++start;
+
         const auto map = std::make_shared<associations>(
-            query.get_unassociated_above(requested_, inventory_, stop));
+            query.get_unassociated_above(start, get_map_size(add1(start)),
+                stop));
 
         if (!set_map(map))
             break;
@@ -539,15 +649,83 @@ size_t chaser_check::set_unassociated() NOEXCEPT
     return count;
 }
 
-size_t chaser_check::get_inventory_size() const NOEXCEPT
+// Association is read from the candidate window, and otherwise queried (an
+// expensive hashmap search). A queried association is recorded, but not a
+// queried lack of association, as the block may be archived at any time.
+bool chaser_check::is_associated(size_t height) const NOEXCEPT
+{
+    const auto& query = archive();
+    const auto link = query.to_candidate(height);
+    if (is_recorded(height, link))
+        return true;
+
+    if (!query.is_associated(link))
+        return false;
+
+    candidates().set(height, link, candidate_window::state::associated);
+    return true;
+}
+
+bool chaser_check::is_recorded(size_t height) const NOEXCEPT
+{
+    return is_recorded(height, archive().to_candidate(height));
+}
+
+bool chaser_check::is_recorded(size_t height,
+    const header_link& link) const NOEXCEPT
+{
+    return candidates().is_associated(height, link);
+}
+
+// Maps are limited by estimated bytes so that channel rates are comparable
+// and the window tail completes evenly, but never exceed inventory size.
+// Block sizes are modeled from mainnet, so other chains are not limited.
+size_t chaser_check::get_map_size(size_t height) const NOEXCEPT
+{
+    if (is_zero(map_bytes_) || !modeled_)
+        return inventory_;
+
+    const auto count = map_bytes_ / estimate_block_size(height);
+    return std::clamp(count, one, inventory_);
+}
+
+// Lookahead issues work into the next window while the current validates,
+// limited by the estimated bytes of archived but unvalidated blocks (blocks
+// returned). Work is issued only once half of the budget is available, which
+// avoids a small map upon each validation. Lookahead also requires the
+// (mainnet) block size model.
+size_t chaser_check::get_lookahead() const NOEXCEPT
+{
+    if (is_zero(lookahead_bytes_) || !modeled_ || advanced_ >= requested_)
+        return zero;
+
+    const auto size = estimate_block_size(add1(requested_));
+    const auto pending = ceilinged_multiply(requested_ - advanced_, size);
+    if (pending > to_half(lookahead_bytes_))
+        return zero;
+
+    return (lookahead_bytes_ - pending) / size;
+}
+
+// The unassociated count is obtained once per window (a scan), and divided
+// among the actual channels (or the configured number when there are none), limited to
+// the maximum inventory of a get_data message.
+size_t chaser_check::get_inventory_size() NOEXCEPT
 {
     if (is_zero(connections_) || !is_current_chain(false))
         return {};
 
-    const auto& query = archive();
-    const auto fork = query.get_fork();
-    const auto inventory = query.get_unassociated_count_above(fork, step_);
-    return ceilinged_divide(inventory, connections_);
+    if (is_zero(unassociated_))
+    {
+        const auto& query = archive();
+        const auto fork = query.get_fork();
+        unassociated_ = query.get_unassociated_count_above(fork, step_);
+        counted_ = ceilinged_add(fork, step_);
+    }
+
+    // Fewer channels than configured would otherwise exceed the message limit.
+    return std::min<size_t>(ceilinged_divide(unassociated_, channels_),
+        messages::peer::max_inventory);
 }
 
 BC_POP_WARNING()
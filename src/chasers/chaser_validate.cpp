@@ -18,6 +18,8 @@
  */
 #include <bitcoin/node/chasers/chaser_validate.hpp>
 
+#include <latch>
+#include <memory>
 #include <bitcoin/node/chasers/chaser.hpp>
 #include <bitcoin/node/define.hpp>
 #include <bitcoin/node/full_node.hpp>
@@ -38,6 +40,11 @@ chaser_validate::chaser_validate(full_node& node) NOEXCEPT
   : chaser(node),
     validation_threadpool_(node.node_settings().threads_(),
         node.node_settings().thread_priority_()),
+    validation_memory_(node.node_settings().allocation_multiple,
+        node.node_settings().threads_(),
+        possible_narrow_cast<size_t>(node.node_settings().allocation_retain),
+        possible_narrow_cast<size_t>(node.node_settings().huge_page_threshold),
+        node.node_settings().numa_memory),
     validation_strand_(validation_threadpool_.service().get_executor()),
     subsidy_interval_(node.system_settings().subsidy_interval_blocks),
     initial_subsidy_(node.system_settings().initial_subsidy()),
@@ -62,6 +69,9 @@ code chaser_validate::start() NOEXCEPT
             << (system::batched::compiled() ? "no device" : "not compiled")
             << ").");
 
+    if (node_settings().numa_pinning)
+        pin_threads();
+
     set_position(archive().get_fork());
     if (const auto ec = start_batch())
         return fault(ec);
@@ -178,6 +188,9 @@ void chaser_validate::do_bump(height_t) NOEXCEPT
     {
         disk_recovering_.store(false);
         set_position(archive().get_fork());
+
+        // Lost in-flight blocks are below the floor unless it is lowered.
+        candidates().regress(position());
     }
 
     const auto height = add1(position());
@@ -198,7 +211,7 @@ void chaser_validate::do_bumped(height_t height) NOEXCEPT
     while ((validate_backlog_ < maximum_backlog_) && !closed() && !suspended())
     {
         const auto link = query.to_candidate(height);
-        const auto ec = query.get_block_state(link);
+        const auto ec = get_block_state(height, link);
 
         // Must exit on unassociated so they are not set valid in bypass.
         // Given height-based iteration, any block state may be enountered.
@@ -250,6 +263,25 @@ void chaser_validate::do_bumped(height_t height) NOEXCEPT
         // So posted validations continue despite network suspension.
         set_position(height++);
     }
+
+    // Records at and below position are not read again unless regressed.
+    candidates().advance(add1(position()));
+}
+
+// Recorded states are specific to the link, which implies that a recorded
+// state cannot be the result of an earlier candidate chain at the height.
+code chaser_validate::get_block_state(size_t height,
+    const header_link& link) const NOEXCEPT
+{
+    switch (candidates().get(height, link))
+    {
+        case candidate_window::state::checked:
+            return database::error::unvalidated;
+        case candidate_window::state::valid:
+            return database::error::block_valid;
+        default:
+            return archive().get_block_state(link);
+    }
 }
 
 void chaser_validate::post_block(const header_link& link,
@@ -334,9 +366,13 @@ void chaser_validate::notify_block(const code& ec, size_t height,
     }
 
     // VALID BLOCK
+    candidates().set(height, link, candidate_window::state::valid);
     if (!startup) notify(ec, chase::valid, possible_wide_cast<height_t>(height));
     fire(events::block_validated, height);
     LOGV("Block validated: " << height << (bypass ? " (bypass)" : ""));
+
+    if (is_zero(height % allocation_interval))
+        fire_allocation();
 }
 
 // Overrides due to independent priority thread pool
@@ -349,6 +385,7 @@ void chaser_validate::stopping(const code& ec) NOEXCEPT
 
     // Stop threadpool keep-alive, all work must self-terminate to affect join.
     validation_threadpool_.stop();
+    log_allocation();
     chaser::stopping(ec);
 }
 
@@ -361,6 +398,29 @@ void chaser_validate::stop() NOEXCEPT
     }
 }
 
+// Each pin blocks until all have arrived, which ensures that each pool thread
+// executes exactly one. Threads are assigned to nodes in round robin order.
+void chaser_validate::pin_threads() NOEXCEPT
+{
+    const auto threads = node_settings().threads_();
+    const auto arrived = std::make_shared<std::latch>(threads);
+
+    for (auto thread = zero; thread < threads; ++thread)
+        PARALLEL(do_pin, thread, arrived);
+}
+
+void chaser_validate::do_pin(size_t thread, const latch_ptr& arrived) NOEXCEPT
+{
+    if (numa::pin(thread % numa::nodes()))
+        ++pinned_;
+
+    arrived->arrive_and_wait();
+
+    if (is_zero(thread))
+        LOGN("Validation threads pinned (" << pinned_.load() << ") across ("
+            << numa::nodes() << ") nodes.");
+}
+
 network::asio::strand& chaser_validate::strand() NOEXCEPT
 {
     return validation_strand_;
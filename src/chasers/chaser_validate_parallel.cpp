@@ -41,9 +41,7 @@ void chaser_validate::validate_block(const header_link& link,
     bool batched{}, capturing{};
     auto& query = archive();
 
-    // TODO: implement allocator parameter resulting in full allocation to
-    // shared_ptr<block>, to optimize deallocate (12% of milestone/filter).
-    const auto block = query.get_block(link, node_witness_);
+    const auto block = get_block(link);
 
     if (!block)
     {
@@ -69,6 +67,53 @@ void chaser_validate::validate_block(const header_link& link,
     complete_block(ec, link, ctx.height, bypass, batched, capturing);
 }
 
+// Deserialize the stored block into the calling thread's arena, so that the
+// block is torn down by one chunk chain release (vs. per object deallocate).
+// This serializes the stored block to wire and parses it again, as the store
+// does not construct into an arena, so it is disabled by default (zero
+// allocation_multiple) until that cost is measured against its savings.
+chain::block::cptr chaser_validate::get_block(
+    const header_link& link) NOEXCEPT
+{
+    const auto& query = archive();
+    if (!validation_memory_.enabled())
+        return query.get_block(link, node_witness_);
+
+    return validation_memory_.deserialize(
+        query.get_wire_block(link, node_witness_), node_witness_);
+}
+
+// Objects per block is the number of allocator calls, each of which was a
+// system allocation without the arena. Arena system allocations are chunks
+// not recycled.
+void chaser_validate::log_allocation() const NOEXCEPT
+{
+    const auto blocks = validation_memory_.blocks();
+    if (is_zero(blocks))
+        return;
+
+    LOGN("Validation allocations per block, objects ("
+        << validation_memory_.objects() / blocks << ") chunks ("
+        << validation_memory_.chunks() / blocks << ") system ("
+        << validation_memory_.misses() / blocks << ").");
+}
+
+void chaser_validate::fire_allocation() NOEXCEPT
+{
+    const auto& memory = validation_memory_;
+    fire(events::memory_live, memory.live());
+    fire(events::memory_peak, memory.peak());
+    fire(events::memory_fallbacks, memory.fallbacks());
+
+    const auto blocks = memory.blocks();
+    if (is_zero(blocks))
+        return;
+
+    fire(events::memory_bytes, memory.bytes() / blocks);
+    fire(events::memory_chunks, (memory.chunks() * 100u) / blocks);
+    fire(events::memory_padding, memory.padding() / blocks);
+}
+
 // helpers
 // ----------------------------------------------------------------------------
 
@@ -42,6 +42,7 @@ DEFINE_ERROR_T_MESSAGE_MAP(error)
     { sacrificed_channel, "sacrificed channel" },
     { suspended_channel, "sacrificed channel" },
     { suspended_service, "sacrificed service" },
+    { disfavored_channel, "disfavored channel" },
 
     // blockchain
     { orphan_block, "orphan block" },
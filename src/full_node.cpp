@@ -41,6 +41,15 @@ full_node::full_node(query& query, const configuration& configuration,
     config_(configuration),
     start_time_(zulu_time()),
     query_(query),
+    memory_(configuration.node.inbound_allocation_multiple,
+        configuration.network.threads,
+        possible_narrow_cast<size_t>(configuration.node.allocation_retain),
+        possible_narrow_cast<size_t>(configuration.node.huge_page_threshold),
+        configuration.node.numa_memory),
+    candidates_(ceilinged_multiply(two,
+        configuration.node.maximum_concurrency_())),
+    ingest_threadpool_(configuration.node.ingest_threads,
+        configuration.node.thread_priority_()),
     chaser_block_(*this),
     chaser_header_(*this),
     chaser_check_(*this),
@@ -69,6 +78,16 @@ void full_node::start(result_handler&& handler) NOEXCEPT
         return;
     }
 
+    // Records begin above the validated (fork) position, advanced thereafter.
+    candidates_.advance(add1(query_.get_fork()));
+
+    // Delivery history is optional, an absent or invalid file is ignored.
+    const auto& file = config_.node.reputation_file;
+    if (!file.empty() && !reputation_.load(file))
+    {
+        LOGN("Peer reputation not loaded from " << file << ".");
+    }
+
     // Base (net) invokes do_start().
     net::start(std::move(handler));
 }
@@ -137,6 +156,19 @@ void full_node::close() NOEXCEPT
     chaser_estimate_.stop();
     chaser_snapshot_.stop();
     chaser_storage_.stop();
+
+    // Block on ingest completion (pending channel work self-terminates).
+    if (!ingest_threadpool_.join())
+    {
+        BC_ASSERT_MSG(false, "failed to join threadpool");
+        std::abort();
+    }
+
+    const auto& file = config_.node.reputation_file;
+    if (!file.empty() && !reputation_.save(file))
+    {
+        LOGF("Peer reputation not saved to " << file << ".");
+    }
 }
 
 // Base (net) invokes do_close().
@@ -156,6 +188,9 @@ void full_node::do_close() NOEXCEPT
     chaser_snapshot_.stopping(network::error::service_stopped);
     chaser_storage_.stopping(network::error::service_stopped);
 
+    // Stop ingest threadpool keep-alive, channels are stopping.
+    ingest_threadpool_.stop();
+
     event_subscriber_.stop(network::error::service_stopped, chase::stop, {});
     net::do_close();
 }
@@ -202,6 +237,11 @@ void full_node::do_notify(const code& ec, chase event_,
     event_value value) NOEXCEPT
 {
     BC_ASSERT(stranded());
+
+    // Records are link specific, so this is compaction (not correctness).
+    if (event_ == chase::regressed || event_ == chase::disorganized)
+        candidates_.regress(std::get<height_t>(value));
+
     event_subscriber_.notify(ec, event_, value);
 }
 
@@ -399,6 +439,26 @@ const node::settings& full_node::node_settings() const NOEXCEPT
     return config_.node;
 }
 
+block_memory& full_node::get_memory() NOEXCEPT
+{
+    return memory_;
+}
+
+candidate_window& full_node::candidates() NOEXCEPT
+{
+    return candidates_;
+}
+
+peer_reputation& full_node::reputation() NOEXCEPT
+{
+    return reputation_;
+}
+
+network::asio::io_context& full_node::ingest_service() NOEXCEPT
+{
+    return ingest_threadpool_.service();
+}
+
 bool full_node::is_current_chain(bool confirmed) const NOEXCEPT
 {
     if (is_zero(config_.node.currency_window_minutes))
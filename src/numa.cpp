@@ -0,0 +1,145 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/numa.hpp>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <string>
+#include <bitcoin/node/define.hpp>
+
+#if defined(__linux__)
+    #include <sched.h>
+    #include <unistd.h>
+    #include <sys/syscall.h>
+    #include <linux/mempolicy.h>
+#endif
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+#if defined(__linux__)
+
+static const std::string sysfs_node{ "/sys/devices/system/node/" };
+
+// Invoke handler(first, last) for each range of a sysfs list ("0-3,8,10-11").
+template <typename Handler>
+static bool parse_list(const std::string& path, Handler&& handler) NOEXCEPT
+{
+    std::ifstream file{ path };
+    std::string text{};
+    if (!std::getline(file, text))
+        return false;
+
+    for (const auto& token : split(text, ","))
+    {
+        const auto range = split(token, "-");
+        size_t first{}, last{};
+        if (range.empty() || !deserialize(first, range.front()) ||
+            !deserialize(last, range.back()) || last < first)
+            return false;
+
+        handler(first, last);
+    }
+
+    return true;
+}
+
+#endif
+
+size_t numa::nodes() NOEXCEPT
+{
+#if defined(__linux__)
+    // Nodes may be sparse, so the count is one above the highest online.
+    static const auto count = []() NOEXCEPT
+    {
+        size_t highest{};
+        return parse_list(sysfs_node + "online",
+            [&](size_t, size_t last) NOEXCEPT
+            {
+                highest = std::max(highest, last);
+            }) ? add1(highest) : one;
+    }();
+
+    return count;
+#else
+    return one;
+#endif
+}
+
+size_t numa::node() NOEXCEPT
+{
+#if defined(__linux__)
+    unsigned int cpu{}, node{};
+    if (is_zero(::syscall(SYS_getcpu, &cpu, &node, nullptr)))
+        return node;
+#endif
+
+    return zero;
+}
+
+bool numa::bind(void* address, size_t bytes, size_t node) NOEXCEPT
+{
+#if defined(__linux__)
+    using word = unsigned long;
+    constexpr auto width = bits<word>;
+    std::array<word, 16> mask{};
+    if (is_null(address) || node >= mask.size() * width)
+        return false;
+
+    BC_PUSH_WARNING(NO_ARRAY_INDEXING)
+    mask[node / width] = power2<word>(node % width);
+    BC_POP_WARNING()
+
+    // MPOL_PREFERRED falls back to other nodes when the node is exhausted.
+    return is_zero(::syscall(SYS_mbind, address, bytes, MPOL_PREFERRED,
+        mask.data(), add1(mask.size() * width), 0));
+#else
+    return false;
+#endif
+}
+
+bool numa::pin(size_t node) NOEXCEPT
+{
+#if defined(__linux__)
+    cpu_set_t set{};
+    CPU_ZERO(&set);
+    const auto path = sysfs_node + "node" + std::to_string(node) + "/cpulist";
+    const auto parsed = parse_list(path, [&](size_t first, size_t last) NOEXCEPT
+    {
+        for (auto cpu = first; cpu <= last && cpu < CPU_SETSIZE; ++cpu)
+            CPU_SET(cpu, &set);
+    });
+
+    // Zero is the calling thread.
+    return parsed && is_nonzero(CPU_COUNT(&set)) &&
+        is_zero(::sched_setaffinity(0, sizeof(set), &set));
+#else
+    return false;
+#endif
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
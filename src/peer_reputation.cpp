@@ -0,0 +1,264 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/node/peer_reputation.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <shared_mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <bitcoin/node/define.hpp>
+
+namespace libbitcoin {
+namespace node {
+
+using namespace system;
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+peer_reputation::peer_reputation(size_t capacity, double smoothing) NOEXCEPT
+  : capacity_(capacity),
+    smoothing_(smoothing > 0.0 && smoothing < 1.0 ? smoothing : 1.0)
+{
+}
+
+peer_reputation::~peer_reputation() NOEXCEPT
+{
+}
+
+// An IPv6 host is bracketed when followed by a port, so an unbracketed address
+// with more than one colon is an IPv6 host without port.
+std::string peer_reputation::to_host(const std::string& address) NOEXCEPT
+{
+    if (address.starts_with('['))
+    {
+        const auto end = address.find(']');
+        return end == std::string::npos ? address :
+            address.substr(one, sub1(end));
+    }
+
+    const auto colon = address.find(':');
+    if (colon == std::string::npos || colon != address.rfind(':'))
+        return address;
+
+    return address.substr(zero, colon);
+}
+
+// record
+// ----------------------------------------------------------------------------
+
+void peer_reputation::delivered(const std::string& peer, double rate) NOEXCEPT
+{
+    if (!(rate > 0.0))
+        return;
+
+    std::unique_lock lock{ mutex_ };
+    auto& value = get_(peer);
+    value.rate = is_zero(value.samples) && is_zero(value.rate) ? rate :
+        value.rate + smoothing_ * (rate - value.rate);
+    value.samples = ceilinged_add(value.samples, 1_u32);
+}
+
+void peer_reputation::stalled(const std::string& peer) NOEXCEPT
+{
+    std::unique_lock lock{ mutex_ };
+    auto& value = get_(peer);
+    value.stalls = ceilinged_add(value.stalls, 1_u32);
+}
+
+void peer_reputation::dropped(const std::string& peer) NOEXCEPT
+{
+    std::unique_lock lock{ mutex_ };
+    auto& value = get_(peer);
+    value.drops = ceilinged_add(value.drops, 1_u32);
+}
+
+// query
+// ----------------------------------------------------------------------------
+
+double peer_reputation::score(const std::string& peer) const NOEXCEPT
+{
+    std::shared_lock lock{ mutex_ };
+    const auto it = records_.find(peer);
+    return it == records_.end() ? 0.0 : score(it->second);
+}
+
+double peer_reputation::rank(const std::string& peer) const NOEXCEPT
+{
+    std::shared_lock lock{ mutex_ };
+    const auto it = records_.find(peer);
+    if (it == records_.end())
+        return 0.5;
+
+    size_t lower{};
+    size_t equal{};
+    const auto value = score(it->second);
+    for (const auto& item: records_)
+    {
+        const auto other = score(item.second);
+        if (other < value)
+            ++lower;
+        else if (!(value < other))
+            ++equal;
+    }
+
+    return (to_floating(lower) + 0.5 * to_floating(equal)) /
+        to_floating(records_.size());
+}
+
+bool peer_reputation::is_poor(const std::string& peer) const NOEXCEPT
+{
+    std::shared_lock lock{ mutex_ };
+    const auto it = records_.find(peer);
+    if (it == records_.end())
+        return false;
+
+    const auto fails = failures(it->second);
+    return fails >= poor_failures && fails > it->second.samples;
+}
+
+size_t peer_reputation::size() const NOEXCEPT
+{
+    std::shared_lock lock{ mutex_ };
+    return records_.size();
+}
+
+// persistence
+// ----------------------------------------------------------------------------
+
+bool peer_reputation::load(const std::filesystem::path& file) NOEXCEPT
+{
+    std::ifstream stream{ extended_path(file) };
+    if (!stream.good())
+        return false;
+
+    records loaded{};
+    std::string line{};
+    while (std::getline(stream, line))
+    {
+        if (line.empty())
+            continue;
+
+        std::string peer{};
+        record value{};
+        std::istringstream fields{ line };
+        if (!(fields >> peer >> value.rate >> value.samples >> value.stalls
+            >> value.drops) || !(value.rate >= 0.0))
+            return false;
+
+        // History ages by half upon each restart.
+        value.samples = to_half(value.samples);
+        value.stalls = to_half(value.stalls);
+        value.drops = to_half(value.drops);
+        loaded[peer] = value;
+    }
+
+    std::unique_lock lock{ mutex_ };
+    records_ = std::move(loaded);
+    return true;
+}
+
+bool peer_reputation::save(const std::filesystem::path& file) const NOEXCEPT
+{
+    using item = records::const_pointer;
+    std::vector<item> items{};
+
+    std::shared_lock lock{ mutex_ };
+    items.reserve(records_.size());
+    for (const auto& record: records_)
+        items.push_back(&record);
+
+    // Retain the peers with the most evidence (good or bad) up to capacity.
+    if (items.size() > capacity_)
+    {
+        const auto end = std::next(items.begin(), capacity_);
+        std::nth_element(items.begin(), end, items.end(),
+            [](item left, item right) NOEXCEPT
+            {
+                return evidence(left->second) > evidence(right->second);
+            });
+
+        items.erase(end, items.end());
+    }
+
+    // Written to a temporary and renamed, so that a crash cannot truncate.
+    auto temporary = file;
+    temporary += ".tmp";
+    {
+        std::ofstream stream{ extended_path(temporary) };
+        for (const auto& record: items)
+            stream << record->first << " " << record->second.rate << " "
+                << record->second.samples << " " << record->second.stalls
+                << " " << record->second.drops << "\n";
+
+        stream.flush();
+        if (!stream.good())
+            return false;
+    }
+
+    std::error_code ec{};
+    std::filesystem::rename(extended_path(temporary), extended_path(file), ec);
+    return !ec;
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+// Must be locked. Records are bounded in memory by evicting the least
+// evidenced record upon insert, as peer addresses are unbounded.
+peer_reputation::record& peer_reputation::get_(const std::string& peer) NOEXCEPT
+{
+    if (const auto it = records_.find(peer); it != records_.end())
+        return it->second;
+
+    if (!records_.empty() && records_.size() >= capacity_)
+    {
+        records_.erase(std::min_element(records_.begin(), records_.end(),
+            [](const auto& left, const auto& right) NOEXCEPT
+            {
+                return evidence(left.second) < evidence(right.second);
+            }));
+    }
+
+    return records_[peer];
+}
+
+// Each failure further discounts the rate (one failure halves it).
+double peer_reputation::score(const record& value) NOEXCEPT
+{
+    return value.rate / (1.0 + to_floating(failures(value)));
+}
+
+uint32_t peer_reputation::failures(const record& value) NOEXCEPT
+{
+    return ceilinged_add(value.stalls, value.drops);
+}
+
+uint32_t peer_reputation::evidence(const record& value) NOEXCEPT
+{
+    return ceilinged_add(value.samples, failures(value));
+}
+
+BC_POP_WARNING()
+
+} // namespace node
+} // namespace libbitcoin
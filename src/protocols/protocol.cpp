@@ -36,6 +36,16 @@ query& protocol::archive() const NOEXCEPT
     return session_->archive();
 }
 
+candidate_window& protocol::candidates() const NOEXCEPT
+{
+    return session_->candidates();
+}
+
+peer_reputation& protocol::reputation() const NOEXCEPT
+{
+    return session_->reputation();
+}
+
 const node::configuration& protocol::node_config() const NOEXCEPT
 {
     return session_->node_config();
@@ -19,6 +19,7 @@
 #include <bitcoin/node/protocols/protocol_block_in_31800.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <bitcoin/node/chasers/chasers.hpp>
 #include <bitcoin/node/define.hpp>
 
@@ -32,6 +33,7 @@ using namespace system;
 using namespace database;
 using namespace network;
 using namespace network::messages::peer;
+using namespace std::chrono;
 using namespace std::placeholders;
 
 // Shared pointers required for lifetime in handler parameters.
@@ -49,6 +51,8 @@ void protocol_block_in_31800::start() NOEXCEPT
     if (started())
         return;
 
+    seed_depth();
+
     // Events subscription is asynchronous, events may be missed.
     subscribe_chase(BIND(handle_chase, _1, _2, _3));
     SUBSCRIBE_CHANNEL(block, handle_receive_block, _1, _2);
@@ -72,7 +76,7 @@ void protocol_block_in_31800::subscribed(const code& ec, object_key) NOEXCEPT
     if (is_current_chain(false))
     {
         start_performance();
-        get_hashes(BIND(handle_get_hashes, _1, _2, _3));
+        fetch();
     }
 }
 
@@ -81,7 +85,9 @@ void protocol_block_in_31800::stopping(const code& ec) NOEXCEPT
 {
     BC_ASSERT(stranded());
     restore(map_);
+    restore(unrequested_);
     map_ = chaser_check::empty_map();
+    unrequested_ = chaser_check::empty_map();
     stop_performance();
     unsubscribe_chase();
     protocol_performer::stopping(ec);
@@ -93,7 +99,7 @@ void protocol_block_in_31800::stopping(const code& ec) NOEXCEPT
 bool protocol_block_in_31800::is_idle() const NOEXCEPT
 {
     BC_ASSERT(stranded());
-    return map_->empty();
+    return map_->empty() && unrequested_->empty();
 }
 
 bool protocol_block_in_31800::handle_chase(const code&, chase event_,
@@ -109,12 +115,13 @@ bool protocol_block_in_31800::handle_chase(const code&, chase event_,
         {
             // chase::split is posted by notify_one() using subscription key.
             // 'value' is the channel that requested a split to obtain work.
+            // Unrequested work is shed to the pool and the channel continues.
             POST(do_split, peer_t{});
             break;
         }
         case chase::stall:
         {
-            // If this channel has divisible work, split it and stop.
+            // If this channel has unrequested work, shed it and continue.
             // There are no channels reporting work, either stalled or done.
             // This is initiated by any channel notifying chase::starved.
             POST(do_stall, peer_t{});
@@ -122,9 +129,10 @@ bool protocol_block_in_31800::handle_chase(const code&, chase event_,
         }
         case chase::purge:
         {
-            // If have work clear it and stop.
+            // If have work above the branch point drop it and continue.
             // This is initiated by chase::regressed/disorganized.
-            POST(do_purge, peer_t{});
+            BC_ASSERT(std::holds_alternative<height_t>(value));
+            POST(do_purge, std::get<height_t>(value));
             break;
         }
         case chase::download:
@@ -160,67 +168,131 @@ void protocol_block_in_31800::do_report(count_t sequence) NOEXCEPT
     BC_ASSERT(stranded());
 
     // Uses application logging since it outputs to a runtime option.
-    LOGA("Work report [" << sequence << "] is (" << map_->size() << ") for ["
-        << opposite() << "].");
+    const auto& latency = arrivals();
+    LOGA("Work report [" << sequence << "] is (" << map_->size() << ") of ("
+        << (map_->size() + unrequested_->size()) << ") depth (" << depth_
+        << ") latency (" << latency.samples() << ") p50/p90/p99 ("
+        << latency.percentile(0.5) << "/" << latency.percentile(0.9) << "/"
+        << latency.percentile(0.99) << ") ms for [" << opposite() << "].");
 }
 
 void protocol_block_in_31800::do_get_downloads(count_t) NOEXCEPT
 {
     BC_ASSERT(stranded());
 
-    if (stopped() || !is_idle())
+    // New work may be pipelined behind work in flight (none unrequested),
+    // but only below the refill threshold, otherwise exhaustion stands.
+    if (stopped() || !unrequested_->empty() ||
+        (!is_idle() && map_->size() > to_half(depth_)))
         return;
 
+    exhausted_ = false;
+
     // Assume performance was stopped due to exhaustion.
-    start_performance();
-    get_hashes(BIND(handle_get_hashes, _1, _2, _3));
+    if (is_idle())
+        start_performance();
+
+    fetch();
 }
 
-void protocol_block_in_31800::do_purge(peer_t) NOEXCEPT
+// Revoked blocks in flight are accepted upon arrival as unrequested.
+void protocol_block_in_31800::do_purge(height_t branch_point) NOEXCEPT
 {
     BC_ASSERT(stranded());
 
-    if (map_->empty())
+    if (stopped() || is_idle())
+        return;
+
+    // Revoked requests are in flight but no longer expected (not stalls).
+    std::for_each(map_->begin(), map_->end(), [&](const auto& item) NOEXCEPT
+    {
+        if (item.context.height > branch_point)
+            forget(item.hash);
+    });
+
+    const auto revoked = chaser_check::revoke(map_, branch_point) +
+        chaser_check::revoke(unrequested_, branch_point);
+
+    if (is_zero(revoked))
         return;
 
-    LOGV("Purge work (" << map_->size() << ") from [" << opposite() << "].");
-    map_->clear();
-    stop(error::sacrificed_channel);
+    LOGV("Purge work (" << revoked << ") above (" << branch_point
+        << ") from [" << opposite() << "].");
+
+    refill();
 }
 
 void protocol_block_in_31800::do_stall(peer_t) NOEXCEPT
 {
     BC_ASSERT(stranded());
 
-    if (stopped() || (map_->size() <= one))
+    if (stopped())
         return;
 
-    LOGV("Divide work (" << map_->size() << ") from [" << opposite() << "].");
-    restore(chaser_check::split(map_));
-    restore(map_);
-    map_ = chaser_check::empty_map();
-    stop(error::sacrificed_channel);
+    shed();
 }
 
 void protocol_block_in_31800::do_split(peer_t) NOEXCEPT
 {
     BC_ASSERT(stranded());
 
-    if (stopped() || (map_->size() <= one))
+    if (stopped())
         return;
 
-    LOGV("Split work (" << map_->size() << ") from [" << opposite() << "].");
-    restore(chaser_check::split(map_));
+    // The slowest channel may have requested all of its work.
+    if (!shed())
+        shed_tail();
+}
+
+// Unrequested work is divisible without dropping the channel, as none of it
+// is in flight. The upper half (by position) is returned to the pool, where it
+// is obtained by starved channels, and the lower half is retained.
+bool protocol_block_in_31800::shed() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (unrequested_->empty())
+        return false;
+
+    const auto kept = chaser_check::split(unrequested_);
+    LOGV("Shed work (" << unrequested_->size() << ") of ("
+        << (map_->size() + kept->size() + unrequested_->size())
+        << ") from [" << opposite() << "].");
+
+    restore(unrequested_);
+    unrequested_ = kept;
+    return true;
+}
+
+// Requested work is shed only when directed by split and none is unrequested.
+// The upper half (by position) is returned to the pool and no longer expected.
+// Any of it that arrives here later is unrequested (ignored), and any that is
+// archived by both channels is resolved by the candidate window claim.
+bool protocol_block_in_31800::shed_tail() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (map_->size() < two)
+        return false;
+
+    const auto kept = chaser_check::split(map_);
+    std::for_each(map_->begin(), map_->end(), [&](const auto& item) NOEXCEPT
+    {
+        forget(item.hash);
+    });
+
+    LOGV("Shed requested work (" << map_->size() << ") of ("
+        << (map_->size() + kept->size()) << ") from [" << opposite() << "].");
+
     restore(map_);
-    map_ = chaser_check::empty_map();
-    stop(error::sacrificed_channel);
+    map_ = kept;
+    return true;
 }
 
 // request hashes
 // ----------------------------------------------------------------------------
 
-void protocol_block_in_31800::send_get_data(const map_ptr& map,
-    const job::ptr& job) NOEXCEPT
+void protocol_block_in_31800::send_get_data(const map_ptr& map) NOEXCEPT
 {
     BC_ASSERT(stranded());
 
@@ -230,19 +302,71 @@ void protocol_block_in_31800::send_get_data(const map_ptr& map,
         return;
     }
 
+    fetching_ = false;
+
+    // A pipelined fetch that finds no work does not imply starvation, and is
+    // not repeated until more work is announced (chase::download).
     if (map->empty())
+    {
+        if (is_idle())
+            notify(error::success, chase::starved, events_key());
+        else
+            exhausted_ = true;
+
         return;
+    }
 
-    // There are two populated maps, return new and leave old in place.
-    if (!is_idle())
+    // The previous map is not fully requested, return new and leave old.
+    if (!unrequested_->empty())
     {
         restore(map);
         return;
     }
 
-    job_ = job;
-    map_ = map;
-    SEND(create_get_data(*map_), handle_send, _1);
+    // At most two maps are in flight, the tail of the previous and this.
+    unrequested_ = map;
+    request();
+}
+
+// Obtain the next map, with at most one request outstanding.
+void protocol_block_in_31800::fetch() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (fetching_)
+        return;
+
+    fetching_ = true;
+    get_hashes(BIND(handle_get_hashes, _1, _2));
+}
+
+// Top up blocks in flight to depth, leaving the remainder sheddable.
+void protocol_block_in_31800::request() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    const auto depth = floored_subtract(depth_, map_->size());
+    const auto next = chaser_check::take(unrequested_, depth);
+    if (next->empty())
+        return;
+
+    // Round trip is sampled from a request made with nothing in flight.
+    if (map_->empty())
+        requested_ = steady_clock::now();
+
+    // Expected arrival is the round trip plus transfer of all bytes ahead of
+    // the block (including those in flight), unknown until both are sampled.
+    const auto known = !is_zero(rate_) && !is_zero(delay_);
+    auto ahead = to_floating(map_->size()) * size_;
+    std::for_each(next->pos_begin(), next->pos_end(), [&](const auto& item) NOEXCEPT
+    {
+        ahead += size_;
+        const duration<double> expected{ known ? delay_ + ahead / rate_ : 0.0 };
+        expect(item.hash, duration_cast<steady_clock::duration>(expected));
+    });
+
+    SEND(create_get_data(*next), handle_send, _1);
+    map_->merge(*next);
 }
 
 get_data protocol_block_in_31800::create_get_data(
@@ -276,6 +400,8 @@ bool protocol_block_in_31800::handle_receive_block(const code& ec,
 
     const auto& block = message->block;
     const auto hash = block.hash();
+    arrived(hash);
+
     const auto it = map_->find(hash);
     if (it == map_->end())
     {
@@ -288,6 +414,14 @@ bool protocol_block_in_31800::handle_receive_block(const code& ec,
     auto& query = archive();
     const auto link = it->link;
     const auto height = it->context.height;
+
+    // End-game duplicate arrived late (first arrival wins), drop cheaply.
+    if (candidates().get(height, link) != candidate_window::state::unknown)
+    {
+        drop(it, block.serialized_size(true));
+        return true;
+    }
+
     const auto checked = is_under_checkpoint(height);
     const auto bypass = checked || query.is_milestone(link);
     if (node_pruned_ && bypass && block.is_segregated())
@@ -297,6 +431,37 @@ bool protocol_block_in_31800::handle_receive_block(const code& ec,
         return false;
     }
 
+    // Identify and commit block off of the channel strand when enabled, so the
+    // next block is read while this one is hashed and stored. The ingest
+    // strand is per channel, so completions are posted in order of receipt.
+    if (ingest_)
+    {
+        boost::asio::post(ingest_strand_,
+            BIND(do_ingest, message, *it, checked, bypass));
+        return true;
+    }
+
+    if (const auto code = ingest(message, *it, bypass))
+    {
+        handle_ingested(code, message, hash);
+        return true;
+    }
+
+    handle_ingested(commit(message, *it, checked, bypass), message, hash);
+    return true;
+}
+
+// Thread safe (ingest strand or channel strand).
+// Identify the block and claim its height, success implies commit required.
+code protocol_block_in_31800::ingest(const block::cptr& message,
+    const association& item, bool bypass) NOEXCEPT
+{
+    auto& query = archive();
+    const auto& block = message->block;
+    const auto& hash = item.hash;
+    const auto link = item.link;
+    const auto height = item.context.height;
+
     // Identify block.
     // ........................................................................
 
@@ -304,7 +469,7 @@ bool protocol_block_in_31800::handle_receive_block(const code& ec,
     // only stored when a strong header has been stored, later to be found out
     // as invalid and not malleable. Stored invalidity prevents repeat
     // processing of the same invalid chain but is not necessary or desirable.
-    if (const auto code = identify(block, it->context, bypass))
+    if (const auto code = identify(block, item.context, bypass))
     {
         if (code == system::error::invalid_transaction_commitment ||
             code == system::error::invalid_witness_commitment)
@@ -313,58 +478,165 @@ bool protocol_block_in_31800::handle_receive_block(const code& ec,
                 << "] from [" << opposite() << "] " << code.message()
                 << " txs(" << block.transactions() << ")"
                 << " segregated(" << block.is_segregated() << ").");
-            stop(code);
-            return false;
+            return code;
         }
 
         if (!query.set_block_unconfirmable(link))
-        {
-            stop(fault(error::protocol1));
-            return false;
-        }
+            return fault(error::protocol1);
 
         LOGR("Block failed check [" << encode_hash(hash) << ":" << height
             << "] from [" << opposite() << "] " << code.message());
         notify(error::success, chase::unchecked, link);
         fire(events::block_unconfirmable, height);
-        stop(code);
-        return false;
+        return code;
     }
 
+    // Claim block.
+    // ........................................................................
+
+    // Claim the height so that a racing end-game duplicate is not archived.
+    if (!candidates().claim(height, link, candidate_window::state::claimed))
+        return error::duplicate_block;
+
+    return error::success;
+}
+
+// Thread safe (ingest strand or channel strand).
+// Commit block.txs of an identified and claimed block. Writes are not combined
+// across channels, as a single writer serializes the store and was measured
+// slower than concurrent channel writes (see ingest_threads).
+code protocol_block_in_31800::commit(const block::cptr& message,
+    const association& item, bool checked, bool bypass) NOEXCEPT
+{
+    auto& query = archive();
+    const auto& block = message->block;
+    const auto& hash = item.hash;
+    const auto link = item.link;
+    const auto height = item.context.height;
+
     // Commit block.txs.
     // ........................................................................
 
-    // Pruned nodes do not store input script or witness under bypass.
+    // Bypass blocks are ingested in one pass over the wire frame, as the view
+    // is not deserialized to chain objects and set_code writes from it. Pruned
+    // nodes do not store input script or witness under bypass (stripped in the
+    // write), and do not request witness under bypass (see to_block_type).
     const auto prune = bypass && node_pruned_;
     if (const auto code = query.set_code(block, link, checked, bypass, height,
         prune))
     {
+        // Release the claim so that the block is downloaded again (resume).
+        candidates().unclaim(height, link);
         LOGF("Failure storing block [" << encode_hash(hash) << ":" << height
             << "] from [" << opposite() << "] " << code.message());
-
-        stop(fault(code));
-        return false;
+        return fault(code);
     }
 
-    // Advance.
-    // ........................................................................
-
     LOGP("Downloaded block [" << encode_hash(hash) << ":" << height
         << "] from [" << opposite() << "].");
 
-    notify(ec, chase::checked, height);
+    // Recorded before notify so that chasers need not query association.
+    candidates().set(height, link, candidate_window::state::checked);
+    notify(error::success, chase::checked, height);
     fire(events::block_archived, height);
+    return error::success;
+}
+
+// A stopping channel has restored its work, so none is committed.
+void protocol_block_in_31800::do_ingest(const block::cptr& message,
+    const association& item, bool checked, bool bypass) NOEXCEPT
+{
+    if (stopped())
+    {
+        POST(handle_ingested, network::error::service_stopped, message,
+            item.hash);
+        return;
+    }
+
+    if (const auto code = ingest(message, item, bypass))
+    {
+        POST(handle_ingested, code, message, item.hash);
+        return;
+    }
+
+    POST(handle_ingested, commit(message, item, checked, bypass), message,
+        item.hash);
+}
+
+// ingest completion
+// ----------------------------------------------------------------------------
 
-    count(block.serialized_size(true));
+// The request may have been revoked or shed while ingesting.
+void protocol_block_in_31800::handle_ingested(const code& ec,
+    const block::cptr& message, const hash_digest& hash) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (stopped())
+        return;
+
+    const auto size = message->block.serialized_size(true);
+    const auto it = map_->find(hash);
+    if (ec == error::duplicate_block)
+    {
+        if (it != map_->end())
+            drop(it, size);
+
+        return;
+    }
+
+    if (ec)
+    {
+        stop(ec);
+        return;
+    }
+
+    count(size);
+    sample(size);
     set_current(is_current_chain(true));
+    if (it != map_->end())
+        map_->erase(it);
+
+    refill();
+}
+
+// Counted toward performance, as the channel delivered the requested block.
+// A dropped block is claimed by another channel (or archived), so this
+// channel holds no claim to release.
+void protocol_block_in_31800::drop(const associations::iterator& it,
+    size_t size) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    LOGV("Duplicate block [" << it->context.height << "] from ["
+        << opposite() << "].");
+
+    count(size);
+    sample(size);
     map_->erase(it);
+    refill();
+}
+
+// Obtain more work when idle, otherwise top up requests at half depth. Once
+// all work is requested, the next map is obtained at the same low-water mark,
+// so that its requests follow without an idle round trip (pipelined).
+void protocol_block_in_31800::refill() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
     if (is_idle())
     {
-        job_.reset();
-        get_hashes(BIND(handle_get_hashes, _1, _2, _3));
+        // Rate is not sampled across the wait for work.
+        reset_sample();
+        exhausted_ = false;
+        fetch();
+    }
+    else if (map_->size() <= to_half(depth_))
+    {
+        request();
+        if (unrequested_->empty() && !exhausted_)
+            fetch();
     }
-
-    return true;
 }
 
 // Header is checked by organize, Check/Accept/Connect are called by validate.
@@ -386,6 +658,78 @@ code protocol_block_in_31800::identify(const chain::block_view& block,
     return error::success;
 }
 
+// request depth
+// ----------------------------------------------------------------------------
+
+// Depth is the number of blocks that fill the bandwidth-delay product of the
+// channel (with headroom), so that fast and near channels are given deeper
+// pipelines and slow or distant channels shallower ones. Rate, round trip and
+// block size are smoothed, and depth is recalculated once per rate period.
+void protocol_block_in_31800::sample(size_t bytes) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    const auto smooth = [](double& value, double sample) NOEXCEPT
+    {
+        value = is_zero(value) ? sample : value + smoothing * (sample - value);
+    };
+
+    const auto now = steady_clock::now();
+    smooth(size_, to_floating(bytes));
+
+    // Time to first block less its own transfer time is the round trip.
+    if (requested_ != steady_clock::time_point{})
+    {
+        const auto elapsed = duration<double>(now - requested_).count();
+        const auto transfer = is_zero(rate_) ? 0.0 : size_ / rate_;
+        smooth(delay_, std::max(elapsed - transfer, 0.0));
+        requested_ = {};
+    }
+
+    if (sampled_ == steady_clock::time_point{})
+    {
+        sampled_ = now;
+        return;
+    }
+
+    received_ = ceilinged_add(received_, bytes);
+    const auto period = duration<double>(now - sampled_).count();
+    if (period < rate_period_seconds)
+        return;
+
+    smooth(rate_, to_floating(received_) / period);
+    received_ = zero;
+    sampled_ = now;
+
+    if (is_zero(delay_) || is_zero(size_))
+        return;
+
+    const auto blocks = depth_headroom * rate_ * delay_ / size_;
+    depth_ = std::clamp(to_ceilinged_integer<size_t>(blocks), minimum_depth,
+        maximum_depth);
+}
+
+// Initial depth is scaled by the peer's rank in persisted delivery history,
+// so that the best rated peers request the most work upon startup (an unknown
+// peer ranks at the median and is given the initial depth).
+void protocol_block_in_31800::seed_depth() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    const auto rank = reputation().rank(peer_reputation::to_key(opposite()));
+    const auto blocks = 2.0 * rank * to_floating(initial_depth);
+    depth_ = std::clamp(to_ceilinged_integer<size_t>(blocks), minimum_depth,
+        maximum_depth);
+}
+
+void protocol_block_in_31800::reset_sample() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    received_ = zero;
+    sampled_ = {};
+    requested_ = {};
+}
+
 // get/put hashes
 // ----------------------------------------------------------------------------
 
@@ -407,7 +751,7 @@ void protocol_block_in_31800::handle_put_hashes(const code& ec,
 }
 
 void protocol_block_in_31800::handle_get_hashes(const code& ec,
-    const map_ptr& map, const job::ptr& job) NOEXCEPT
+    const map_ptr& map) NOEXCEPT
 {
     LOGV("Got (" << map->size() << ") work for [" << opposite() << "].");
 
@@ -424,13 +768,7 @@ void protocol_block_in_31800::handle_get_hashes(const code& ec,
         return;
     }
 
-    if (map->empty())
-    {
-        notify(error::success, chase::starved, events_key());
-        return;
-    }
-
-    POST(send_get_data, map, job);
+    POST(send_get_data, map);
 }
 
 // utility
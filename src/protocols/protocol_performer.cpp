@@ -84,6 +84,8 @@ void protocol_performer::pause_performance() NOEXCEPT
 void protocol_performer::stop_performance() NOEXCEPT
 {
     BC_ASSERT(stranded());
+    arrival_timer_->stop();
+    arrivals_.clear();
     send_performance(zero);
 }
 
@@ -93,6 +95,11 @@ void protocol_performer::send_performance(uint64_t rate) NOEXCEPT
 
     if (enabled_)
     {
+        // Delivery history persists across restarts (by peer address).
+        if (!is_zero(rate) && rate != max_uint64)
+            reputation().delivered(peer_reputation::to_key(opposite()),
+                to_floating(rate));
+
         // Must come first as this takes priority as per configuration.
         // Shared performance manager detects slow and stalled channels.
         if (deviation_)
@@ -135,6 +142,12 @@ void protocol_performer::do_handle_performance(const code& ec) NOEXCEPT
     // Caused only by performance(zero|xxx) - had outstanding work.
     if (ec == error::stalled_channel || ec == error::slow_channel)
     {
+        const auto peer = peer_reputation::to_key(opposite());
+        if (ec == error::stalled_channel)
+            reputation().stalled(peer);
+        else
+            reputation().dropped(peer);
+
         LOGP("Channel dropped [" << opposite() << "] " << ec.message());
         stop(ec);
         return;
@@ -157,5 +170,77 @@ void protocol_performer::count(size_t bytes) NOEXCEPT
     bytes_ = ceilinged_add(bytes_, possible_wide_cast<uint64_t>(bytes));
 }
 
+// expected arrival
+// ----------------------------------------------------------------------------
+
+// A stall is detected once any request is overdue (checked each second),
+// rather than upon a sample period with no bytes.
+void protocol_performer::expect(const hash_digest& hash,
+    steady_clock::duration expected) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    arrivals_.expect(hash, steady_clock::now(), expected);
+    start_arrival_timer();
+}
+
+void protocol_performer::arrived(const hash_digest& hash) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    arrivals_.arrive(hash, steady_clock::now());
+}
+
+void protocol_performer::forget(const hash_digest& hash) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    arrivals_.forget(hash);
+}
+
+const arrival_tracker& protocol_performer::arrivals() const NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    return arrivals_;
+}
+
+void protocol_performer::start_arrival_timer() NOEXCEPT
+{
+    BC_ASSERT(stranded());
+
+    if (!deadlines_ || arrival_timing_ || is_zero(arrivals_.size()))
+        return;
+
+    arrival_timing_ = true;
+    arrival_timer_->start(BIND(handle_arrival_timer, _1));
+}
+
+void protocol_performer::handle_arrival_timer(const code& ec) NOEXCEPT
+{
+    BC_ASSERT(stranded());
+    arrival_timing_ = false;
+
+    if (ec == network::error::operation_canceled ||
+        ec == network::error::service_stopped)
+        return;
+
+    if (stopped())
+        return;
+
+    if (ec)
+    {
+        LOGF("Arrival timer failure, " << ec.message());
+        stop(ec);
+        return;
+    }
+
+    if (arrivals_.is_overdue(steady_clock::now()))
+    {
+        LOGP("Overdue block request (" << arrivals_.size() << ") from ["
+            << opposite() << "].");
+        do_handle_performance(error::stalled_channel);
+        return;
+    }
+
+    start_arrival_timer();
+}
+
 } // namespace node
 } // namespace libbitcoin
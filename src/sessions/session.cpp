@@ -125,6 +125,21 @@ full_node::query& session::archive() const NOEXCEPT
     return node_.archive();
 }
 
+candidate_window& session::candidates() const NOEXCEPT
+{
+    return node_.candidates();
+}
+
+peer_reputation& session::reputation() const NOEXCEPT
+{
+    return node_.reputation();
+}
+
+network::asio::io_context& session::ingest_service() const NOEXCEPT
+{
+    return node_.ingest_service();
+}
+
 const node::configuration& session::node_config() const NOEXCEPT
 {
     return node_.node_config();
@@ -18,8 +18,29 @@
  */
 #include <bitcoin/node/sessions/session_outbound.hpp>
 
+#include <utility>
+#include <bitcoin/node/define.hpp>
+#include <bitcoin/node/peer_reputation.hpp>
+
 namespace libbitcoin {
 namespace node {
 
+// Outbound candidates are drawn from the network address pool, which is not
+// ordered by delivery. A peer that has failed more often than it has delivered
+// is declined before handshake, so that its slot is refilled from the pool.
+void session_outbound::attach_handshake(const channel_ptr& channel,
+    network::result_handler&& handler) NOEXCEPT
+{
+    BC_ASSERT(channel->stranded());
+
+    if (reputation().is_poor(peer_reputation::to_key(channel->opposite())))
+    {
+        handler(error::disfavored_channel);
+        return;
+    }
+
+    base::attach_handshake(channel, std::move(handler));
+}
+
 } // namespace node
 } // namespace libbitcoin
@@ -31,6 +31,7 @@ namespace node {
 
 settings::settings() NOEXCEPT
   : threads{ 1 },
+    ingest_threads{ 0 },
     delay_inbound{ true },
     headers_first{ true },
     memory_priority{ true },
@@ -42,10 +43,21 @@ settings::settings() NOEXCEPT
     require_witness{ true },
     provide_filters{ false },
     limited_blocks{ false },
+    numa_memory{ false },
+    numa_pinning{ false },
+    median_deviation{ false },
     batch_signatures{ 0 },
+    huge_page_threshold{ 0 },
+    allocation_multiple{ 0 },
+    inbound_allocation_multiple{ 0 },
+    allocation_retain{ 33'554'432 },
+    download_map_bytes{ 33'554'432 },
+    lookahead_bytes{ 0 },
     minimum_fee_rate{ 0.0 },
     minimum_bump_rate{ 0.0 },
     allowed_deviation{ 1.5 },
+    speed_smoothing{ 0.5 },
+    stall_factor{ 0.0 },
     announcement_cache{ 42 },
     fee_estimate_horizon{ 0 },
     ////snapshot_bytes{ 200'000'000'000 },
@@ -57,7 +69,8 @@ settings::settings() NOEXCEPT
     sample_period_seconds{ 10 },
     currency_window_minutes{ 1440 },
     warn_dirty_background_ratio{ 90_u16 },
-    warn_dirty_ratio{ 90_u16 }
+    warn_dirty_ratio{ 90_u16 },
+    reputation_file{}
 {
 }
 
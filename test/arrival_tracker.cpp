@@ -0,0 +1,137 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(arrival_tracker_tests)
+
+using namespace std::chrono;
+using steady = arrival_tracker::clock;
+const system::hash_digest hash1{ 1 };
+const system::hash_digest hash2{ 2 };
+
+BOOST_AUTO_TEST_CASE(arrival_tracker__construct__default__empty)
+{
+    const arrival_tracker instance{};
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.samples(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.percentile(0.5), 0u);
+    BOOST_REQUIRE(!instance.is_overdue(steady::now()));
+}
+
+BOOST_AUTO_TEST_CASE(arrival_tracker__to_bucket__boundaries__power_of_two)
+{
+    BOOST_REQUIRE_EQUAL(arrival_tracker::to_bucket(microseconds{ 999 }), 0u);
+    BOOST_REQUIRE_EQUAL(arrival_tracker::to_bucket(milliseconds{ 1 }), 1u);
+    BOOST_REQUIRE_EQUAL(arrival_tracker::to_bucket(milliseconds{ 3 }), 2u);
+    BOOST_REQUIRE_EQUAL(arrival_tracker::to_bucket(milliseconds{ 4 }), 3u);
+    BOOST_REQUIRE_EQUAL(arrival_tracker::to_bucket(hours{ 1 }),
+        sub1(arrival_tracker::buckets));
+}
+
+BOOST_AUTO_TEST_CASE(arrival_tracker__arrive__expected__recorded)
+{
+    arrival_tracker instance{};
+    const auto sent = steady::now();
+    instance.expect(hash1, sent, milliseconds{ 100 });
+    BOOST_REQUIRE_EQUAL(instance.size(), 1u);
+    BOOST_REQUIRE(instance.arrive(hash1, sent + milliseconds{ 50 }));
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.samples(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.latencies().at(6), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(arrival_tracker__forget__expected__not_recorded_not_overdue)
+{
+    arrival_tracker instance{ 2.0 };
+    const auto sent = steady::now();
+    instance.expect(hash1, sent, milliseconds{ 100 });
+    BOOST_REQUIRE(instance.forget(hash1));
+    BOOST_REQUIRE(!instance.forget(hash1));
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.samples(), 0u);
+    BOOST_REQUIRE(!instance.is_overdue(sent + seconds{ 10 }));
+    BOOST_REQUIRE(!instance.arrive(hash1, sent + milliseconds{ 50 }));
+}
+
+BOOST_AUTO_TEST_CASE(arrival_tracker__arrive__unexpected__false)
+{
+    arrival_tracker instance{};
+    BOOST_REQUIRE(!instance.arrive(hash1, steady::now()));
+    BOOST_REQUIRE_EQUAL(instance.samples(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(arrival_tracker__is_overdue__past_factor__true)
+{
+    arrival_tracker instance{ 3.0 };
+    const auto sent = steady::now();
+    instance.expect(hash1, sent, seconds{ 1 });
+    BOOST_REQUIRE(!instance.is_overdue(sent + milliseconds{ 2'999 }));
+    BOOST_REQUIRE(instance.is_overdue(sent + milliseconds{ 3'001 }));
+    BOOST_REQUIRE(instance.arrive(hash1, sent + seconds{ 4 }));
+    BOOST_REQUIRE(!instance.is_overdue(sent + seconds{ 4 }));
+}
+
+BOOST_AUTO_TEST_CASE(arrival_tracker__is_overdue__unknown_expectation__false)
+{
+    arrival_tracker instance{ 3.0 };
+    const auto sent = steady::now();
+    instance.expect(hash1, sent, steady::duration::zero());
+    BOOST_REQUIRE(!instance.is_overdue(sent + hours{ 1 }));
+}
+
+BOOST_AUTO_TEST_CASE(arrival_tracker__is_overdue__disabled__false)
+{
+    arrival_tracker instance{ 0.0 };
+    const auto sent = steady::now();
+    instance.expect(hash1, sent, seconds{ 1 });
+    BOOST_REQUIRE(!instance.is_overdue(sent + hours{ 1 }));
+}
+
+BOOST_AUTO_TEST_CASE(arrival_tracker__clear__outstanding__retains_latencies)
+{
+    arrival_tracker instance{ 3.0 };
+    const auto sent = steady::now();
+    instance.expect(hash1, sent, seconds{ 1 });
+    instance.expect(hash2, sent, seconds{ 1 });
+    BOOST_REQUIRE(instance.arrive(hash1, sent + milliseconds{ 10 }));
+    instance.clear();
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.samples(), 1u);
+    BOOST_REQUIRE(!instance.is_overdue(sent + hours{ 1 }));
+}
+
+BOOST_AUTO_TEST_CASE(arrival_tracker__percentile__distribution__bucket_upper_bounds)
+{
+    arrival_tracker instance{};
+    const auto sent = steady::now();
+    for (uint8_t index = 0; index < 10; ++index)
+    {
+        const system::hash_digest hash{ index };
+        instance.expect(hash, sent, seconds{ 1 });
+        const auto latency = index < 9 ? milliseconds{ 5 } : seconds{ 2 };
+        BOOST_REQUIRE(instance.arrive(hash, sent + latency));
+    }
+
+    BOOST_REQUIRE_EQUAL(instance.percentile(0.5), 8u);
+    BOOST_REQUIRE_EQUAL(instance.percentile(0.9), 8u);
+    BOOST_REQUIRE_EQUAL(instance.percentile(0.99), 2048u);
+    BOOST_REQUIRE_EQUAL(instance.percentile(0.0), 8u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
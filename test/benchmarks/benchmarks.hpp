@@ -0,0 +1,48 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_TEST_BENCHMARKS_HPP
+#define LIBBITCOIN_NODE_TEST_BENCHMARKS_HPP
+
+#include "../test.hpp"
+
+#include <chrono>
+
+namespace test {
+
+/// Wall time of the invocation in nanoseconds.
+template <typename Function>
+inline uint64_t elapsed_ns(Function&& function) NOEXCEPT
+{
+    using namespace std::chrono;
+    const auto start = steady_clock::now();
+    function();
+    const auto span = steady_clock::now() - start;
+    return system::possible_narrow_sign_cast<uint64_t>(
+        duration_cast<nanoseconds>(span).count());
+}
+
+/// Average of total over count, zero if count is zero.
+inline uint64_t per(uint64_t total, size_t count) NOEXCEPT
+{
+    return is_zero(count) ? 0u : total / count;
+}
+
+} // namespace test
+
+#endif
@@ -0,0 +1,182 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "benchmarks.hpp"
+
+#if defined(HAVE_BENCHMARKS)
+
+#include <algorithm>
+#include <thread>
+#include "corpus.hpp"
+
+BOOST_AUTO_TEST_SUITE(block_arena_benchmarks)
+
+using namespace system;
+
+// Deserializes and drops each corpus block, repeated, through block_memory
+// (block_arena) and through a counting proxy of the default allocator. Run
+// with varied multiples to tune block_arena allocation.
+
+constexpr size_t rounds = 50;
+constexpr size_t multiples[]{ 1, 2, 5, 10 };
+
+// Counts and forwards allocations to the default allocator.
+class counting_arena
+  : public arena
+{
+public:
+    void* start(size_t) THROWS override
+    {
+        return nullptr;
+    }
+
+    size_t detach() NOEXCEPT override
+    {
+        return zero;
+    }
+
+    void release(void*) NOEXCEPT override
+    {
+    }
+
+    size_t allocations() const NOEXCEPT
+    {
+        return allocations_;
+    }
+
+    size_t peak() const NOEXCEPT
+    {
+        return peak_;
+    }
+
+protected:
+    void* do_allocate(size_t bytes, size_t align) THROWS override
+    {
+        ++allocations_;
+        const auto live = live_.fetch_add(bytes) + bytes;
+        auto peak = peak_.load();
+        while (live > peak)
+            if (peak_.compare_exchange_weak(peak, live))
+                break;
+
+        return default_arena::get()->allocate(bytes, align);
+    }
+
+    void do_deallocate(void* ptr, size_t bytes,
+        size_t align) NOEXCEPT override
+    {
+        live_ -= bytes;
+        default_arena::get()->deallocate(ptr, bytes, align);
+    }
+
+    bool do_is_equal(const arena& other) const NOEXCEPT override
+    {
+        return &other == this;
+    }
+
+private:
+    std::atomic_size_t allocations_{};
+    std::atomic_size_t live_{};
+    std::atomic_size_t peak_{};
+};
+
+static size_t default_block(counting_arena& counter, const data_chunk& data)
+{
+    stream::in::fast source{ data };
+    read::bytes::fast reader{ source, &counter };
+    const auto block = std::make_unique<chain::block>(reader, true);
+    return block->transactions();
+}
+
+static size_t arena_block(block_memory& memory, const data_chunk& data)
+{
+    const auto block = memory.deserialize(data, true);
+    return block ? block->transactions() : zero;
+}
+
+template <typename Function>
+static uint64_t run(size_t threads, const Function& function)
+{
+    return test::elapsed_ns([&]()
+    {
+        std::vector<std::thread> workers{};
+        for (size_t thread = 0; thread < threads; ++thread)
+        {
+            workers.emplace_back([&]()
+            {
+                for (size_t round = 0; round < rounds; ++round)
+                    function();
+            });
+        }
+
+        for (auto& worker : workers)
+            worker.join();
+    });
+}
+
+static void report(size_t threads)
+{
+    const auto corpus = test::corpus::blocks();
+    const auto total = threads * rounds * corpus.size();
+    std::atomic_size_t txs{};
+
+    counting_arena counter{};
+    const auto ns = run(threads, [&]()
+    {
+        for (const auto& data : corpus)
+            txs += default_block(counter, data);
+    });
+
+    BOOST_TEST_MESSAGE("default (" << threads << " threads): "
+        << test::per(ns, total) << " ns/block, "
+        << test::per(counter.allocations(), total) << " allocations/block, "
+        << counter.peak() << " peak bytes (" << txs << ").");
+
+    for (const auto multiple : multiples)
+    {
+        const auto retain = multiple * 4'000'000u;
+        block_memory memory{ multiple, threads, retain };
+        const auto elapsed = run(threads, [&]()
+        {
+            for (const auto& data : corpus)
+                txs += arena_block(memory, data);
+        });
+
+        BOOST_TEST_MESSAGE("arena x" << multiple << " (" << threads
+            << " threads): " << test::per(elapsed, total) << " ns/block, "
+            << memory.misses() << " allocations, "
+            << test::per(memory.chunks(), memory.blocks()) << " chunks/block, "
+            << memory.peak() << " peak bytes (" << txs << ").");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(block_arena__corpus_single_threaded__benchmark)
+{
+    report(one);
+    BOOST_REQUIRE(true);
+}
+
+BOOST_AUTO_TEST_CASE(block_arena__corpus_multi_threaded__benchmark)
+{
+    report(std::max(std::thread::hardware_concurrency(), 2u));
+    BOOST_REQUIRE(true);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
@@ -0,0 +1,98 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "benchmarks.hpp"
+
+#if defined(HAVE_BENCHMARKS)
+
+#include <algorithm>
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(block_memory_benchmarks)
+
+using namespace system;
+
+// Models inbound block ingest from many peers, each deserializing on its own
+// thread and dropping the block (as after archival). The block is the genesis
+// coinbase repeated to a typical transaction count, which deserializes as a
+// realistic object graph though its merkle root is not valid.
+
+constexpr size_t transactions = 2'000;
+constexpr size_t peers = 16;
+constexpr size_t blocks = 100;
+
+static data_chunk make_block() NOEXCEPT
+{
+    const auto genesis = system::settings{ chain::selection::mainnet }
+        .genesis_block.to_data(true);
+
+    // header (80) | count (1) | coinbase
+    constexpr size_t header = 80;
+    const auto coinbase = std::next(genesis.begin(), add1(header));
+
+    data_chunk data{ genesis.begin(), std::next(genesis.begin(), header) };
+    data.push_back(varint_two_bytes);
+    data.push_back(narrow_cast<uint8_t>(transactions));
+    data.push_back(narrow_cast<uint8_t>(transactions >> byte_bits));
+
+    for (size_t tx = 0; tx < transactions; ++tx)
+        data.insert(data.end(), coinbase, genesis.end());
+
+    return data;
+}
+
+static void report(const std::string& name, size_t multiple)
+{
+    const auto data = make_block();
+    block_memory memory{ multiple, peers, data.size() * 10u };
+
+    std::atomic<size_t> valid{};
+    const auto ns = test::elapsed_ns([&]()
+    {
+        std::vector<std::thread> threads{};
+        for (size_t peer = 0; peer < peers; ++peer)
+        {
+            threads.emplace_back([&]()
+            {
+                for (size_t block = 0; block < blocks; ++block)
+                    if (const auto item = memory.deserialize(data, true))
+                        valid += item->transactions_ptr()->size();
+            });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+    });
+
+    const auto total = peers * blocks;
+    BOOST_TEST_MESSAGE(name << ": " << test::per(ns, total) << " ns/block, "
+        << (total * 1'000'000'000ull) / std::max<uint64_t>(ns, 1u)
+        << " blocks/s, " << memory.misses() << " system allocations ("
+        << valid << ").");
+}
+
+BOOST_AUTO_TEST_CASE(block_memory__ingest__benchmark)
+{
+    report("default allocator", 0);
+    report("block memory", 5);
+    BOOST_REQUIRE(true);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
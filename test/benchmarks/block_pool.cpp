@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "benchmarks.hpp"
+
+#if defined(HAVE_BENCHMARKS)
+
+BOOST_AUTO_TEST_SUITE(block_pool_benchmarks)
+
+using namespace system;
+
+// Run under 'perf stat -e dTLB-load-misses,dTLB-store-misses' to compare TLB
+// misses, for example (with vm.nr_hugepages reserved for explicit mapping):
+// perf stat -e dTLB-load-misses libbitcoin-node-test
+//    --run_test=block_pool_benchmarks/block_pool__huge_pages__benchmark
+
+// A deserialized block is a large graph of small objects allocated in one
+// arena and then walked repeatedly (populate/connect), modeled as a strided
+// pointer chase over fixed size records.
+struct record
+{
+    record* next;
+    uint64_t value[3];
+};
+
+constexpr size_t wire_size = 1'500'000;
+constexpr size_t multiple = 2;
+constexpr size_t records = wire_size / sizeof(record);
+constexpr size_t stride = 4099;
+constexpr size_t walks = 4;
+constexpr size_t blocks = 200;
+
+static uint64_t run_block(block_arena& arena)
+{
+    std::vector<record*> items(records);
+    const auto memory = arena.start(wire_size);
+
+    for (auto& item : items)
+    {
+        item = pointer_cast<record>(arena.allocate(sizeof(record),
+            alignof(record)));
+        item->value[0] = 1;
+    }
+
+    for (size_t index = 0; index < records; ++index)
+        items[index]->next = items[(index * stride + 1u) % records];
+
+    uint64_t sum{};
+    for (size_t walk = 0; walk < walks; ++walk)
+        for (auto item = items.front(), count = records; !is_zero(count--);
+            item = item->next)
+            sum += item->value[0];
+
+    arena.detach();
+    arena.release(memory);
+    return sum;
+}
+
+static void report(const std::string& name, block_arena& arena)
+{
+    uint64_t sum{};
+    const auto ns = test::elapsed_ns([&]() NOEXCEPT
+    {
+        for (size_t block = 0; block < blocks; ++block)
+            sum += run_block(arena);
+    });
+
+    BOOST_TEST_MESSAGE(name << ": " << test::per(ns, blocks) << " ns/block, "
+        << arena.pool().misses() << " system allocations, "
+        << arena.pool().mapped() << " mapped (" << sum << ").");
+}
+
+BOOST_AUTO_TEST_CASE(block_pool__huge_pages__benchmark)
+{
+    block_arena malloc_arena{ multiple };
+    block_arena recycle_arena{ multiple, wire_size * multiple * 2u };
+    block_arena huge_arena{ multiple, wire_size * multiple * 2u,
+        power2(21u) };
+
+    report("std::malloc", malloc_arena);
+    report("recycled", recycle_arena);
+    report("huge pages", huge_arena);
+    BOOST_REQUIRE(true);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
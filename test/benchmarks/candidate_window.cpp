@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "benchmarks.hpp"
+
+#if defined(HAVE_BENCHMARKS)
+
+#include <unordered_map>
+
+BOOST_AUTO_TEST_SUITE(candidate_window_benchmarks)
+
+using namespace system;
+
+// Compare a per height association probe, modeled as a hashmap of the full
+// mainnet chain keyed by header link, to the candidate window over a full
+// download window (maximum_concurrency) at mainnet heights. The candidate
+// index (height to link) is a positional lookup in both cases.
+
+constexpr size_t top = 900'000;
+constexpr size_t window = 50'000;
+constexpr size_t fork = top - window;
+constexpr size_t scans = 20;
+
+using header_link = database::header_link;
+
+static header_t to_link(size_t height) NOEXCEPT
+{
+    return possible_narrow_cast<header_t>(height);
+}
+
+BOOST_AUTO_TEST_CASE(candidate_window__scan__benchmark)
+{
+    std::unordered_map<header_t, bool> associations{};
+    associations.reserve(top);
+    for (size_t height = 0; height < top; ++height)
+        associations.emplace(to_link(height), true);
+
+    candidate_window states{};
+    states.advance(add1(fork));
+    const auto set_ns = test::elapsed_ns([&]() NOEXCEPT
+    {
+        for (auto height = add1(fork); height <= top; ++height)
+            states.set(height, to_link(height),
+                candidate_window::state::checked);
+    });
+
+    size_t probed{};
+    const auto probe_ns = test::elapsed_ns([&]() NOEXCEPT
+    {
+        for (size_t scan = 0; scan < scans; ++scan)
+            for (auto height = add1(fork); height <= top; ++height)
+                probed += associations.find(to_link(height))->second;
+    });
+
+    size_t recorded{};
+    const auto window_ns = test::elapsed_ns([&]() NOEXCEPT
+    {
+        for (size_t scan = 0; scan < scans; ++scan)
+            for (auto height = add1(fork); height <= top; ++height)
+                recorded += (states.get(height, header_link{
+                    to_link(height) }) != candidate_window::state::unknown);
+    });
+
+    const auto heights = scans * window;
+    BOOST_TEST_MESSAGE("window set: " << test::per(set_ns, window)
+        << " ns/height (" << states.size() << " heights).");
+    BOOST_TEST_MESSAGE("hashmap probe: " << test::per(probe_ns, heights)
+        << " ns/height (" << probed << ").");
+    BOOST_TEST_MESSAGE("window get: " << test::per(window_ns, heights)
+        << " ns/height (" << recorded << ").");
+    BOOST_REQUIRE(true);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
@@ -0,0 +1,182 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_NODE_TEST_CORPUS_HPP
+#define LIBBITCOIN_NODE_TEST_CORPUS_HPP
+
+#include "../test.hpp"
+
+namespace test {
+namespace corpus {
+
+// A deterministic corpus of mainnet-shaped wire blocks. Transaction counts,
+// input/output counts and script/witness sizes follow common mainnet forms,
+// with pseudorandom content. Blocks deserialize as realistic object graphs,
+// though hashes, signatures and merkle roots are not valid.
+
+/// Transaction form within a block.
+struct shape
+{
+    size_t transactions;
+    size_t inputs;
+    size_t outputs;
+    size_t input_script;
+    size_t output_script;
+    bool witness;
+};
+
+/// Legacy p2pkh payments, segwit p2wpkh payments, and consolidations.
+constexpr shape legacy{ 1'500, 2, 2, 107, 25, false };
+constexpr shape segwit{ 2'500, 1, 2, 0, 22, true };
+constexpr shape consolidation{ 200, 20, 1, 0, 22, true };
+
+class writer
+{
+public:
+    inline const system::data_chunk& data() const NOEXCEPT
+    {
+        return data_;
+    }
+
+    inline void bytes(size_t count) NOEXCEPT
+    {
+        for (size_t byte = 0; byte < count; ++byte)
+            data_.push_back(next());
+    }
+
+    inline void integer(uint64_t value, size_t size) NOEXCEPT
+    {
+        for (size_t byte = 0; byte < size; ++byte)
+            data_.push_back(system::narrow_cast<uint8_t>(value >> (8u * byte)));
+    }
+
+    inline void variable(uint64_t value) NOEXCEPT
+    {
+        if (value < system::varint_two_bytes)
+        {
+            integer(value, 1);
+        }
+        else if (value <= max_uint16)
+        {
+            integer(system::varint_two_bytes, 1);
+            integer(value, 2);
+        }
+        else
+        {
+            integer(system::varint_four_bytes, 1);
+            integer(value, 4);
+        }
+    }
+
+    inline void script(size_t size) NOEXCEPT
+    {
+        variable(size);
+        bytes(size);
+    }
+
+private:
+    // Deterministic linear congruential content.
+    inline uint8_t next() NOEXCEPT
+    {
+        state_ = state_ * 6364136223846793005ull + 1442695040888963407ull;
+        return system::narrow_cast<uint8_t>(state_ >> 56);
+    }
+
+    uint64_t state_{ 42 };
+    system::data_chunk data_{};
+};
+
+inline void transaction(writer& out, const shape& form, bool coinbase) NOEXCEPT
+{
+    const auto inputs = coinbase ? one : form.inputs;
+    const auto witness = form.witness;
+
+    out.integer(2, 4);
+    if (witness)
+    {
+        out.integer(0, 1);
+        out.integer(1, 1);
+    }
+
+    out.variable(inputs);
+    for (size_t input = 0; input < inputs; ++input)
+    {
+        out.bytes(system::hash_size);
+        out.integer(coinbase ? max_uint32 : input, 4);
+        out.script(coinbase ? 40u : form.input_script);
+        out.integer(max_uint32 - 1u, 4);
+    }
+
+    out.variable(form.outputs);
+    for (size_t output = 0; output < form.outputs; ++output)
+    {
+        out.integer(10'000u + output, 8);
+        out.script(form.output_script);
+    }
+
+    if (witness)
+    {
+        for (size_t input = 0; input < inputs; ++input)
+        {
+            // Coinbase witness is the reserved value, p2wpkh is sig/key.
+            if (coinbase)
+            {
+                out.variable(1);
+                out.script(system::hash_size);
+            }
+            else
+            {
+                out.variable(2);
+                out.script(72);
+                out.script(33);
+            }
+        }
+    }
+
+    out.integer(0, 4);
+}
+
+inline system::data_chunk block(const shape& form) NOEXCEPT
+{
+    writer out{};
+    out.bytes(80);
+    out.variable(form.transactions);
+
+    for (size_t tx = 0; tx < form.transactions; ++tx)
+        transaction(out, form, is_zero(tx));
+
+    return out.data();
+}
+
+/// The corpus, including the (real) mainnet genesis block.
+inline std::vector<system::data_chunk> blocks() NOEXCEPT
+{
+    const system::settings mainnet{ system::chain::selection::mainnet };
+    return
+    {
+        mainnet.genesis_block.to_data(true),
+        block(legacy),
+        block(segwit),
+        block(consolidation)
+    };
+}
+
+} // namespace corpus
+} // namespace test
+
+#endif
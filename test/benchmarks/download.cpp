@@ -0,0 +1,341 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "benchmarks.hpp"
+
+#if defined(HAVE_BENCHMARKS)
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <iterator>
+
+BOOST_AUTO_TEST_SUITE(download_benchmarks)
+
+using namespace system;
+
+// In-process simulation of multi-peer block download, comparing the split
+// scheduler (slowest channel splits all work to the pool and is dropped) to
+// the shedding scheduler (slowest channel sheds half of its unrequested work
+// to the pool and continues). A dropped channel is replaced by a channel of
+// the same rate after a reconnect delay (connect, handshake, slow start).
+// Time is in ticks (10ms), rates are in blocks per tick.
+
+constexpr size_t blocks = 50'000;
+constexpr size_t inventory = 2'500;
+constexpr size_t depth = 50;
+constexpr size_t reconnect = 200;
+constexpr std::array<size_t, 8> rates{ 40, 35, 30, 25, 20, 10, 5, 2 };
+
+struct peer
+{
+    size_t rate;
+    size_t inflight{};
+    size_t unrequested{};
+    size_t idle{};
+};
+
+struct outcome
+{
+    size_t ticks{};
+    size_t drops{};
+    size_t sheds{};
+};
+
+// The pool is a queue of map sizes (chaser_check::maps_).
+using pool = std::deque<size_t>;
+
+static size_t work(const peer& channel) NOEXCEPT
+{
+    return channel.inflight + channel.unrequested;
+}
+
+static void obtain(peer& channel, pool& maps, bool shedding) NOEXCEPT
+{
+    if (maps.empty())
+        return;
+
+    const auto map = maps.front();
+    maps.pop_front();
+    channel.inflight = shedding ? std::min(map, depth) : map;
+    channel.unrequested = map - channel.inflight;
+}
+
+static outcome simulate(bool shedding) NOEXCEPT
+{
+    outcome result{};
+    pool maps{};
+    for (auto remain = blocks; !is_zero(remain);)
+    {
+        const auto map = std::min(inventory, remain);
+        maps.push_back(map);
+        remain -= map;
+    }
+
+    std::vector<peer> peers{};
+    for (const auto rate : rates)
+    {
+        peers.push_back({ rate });
+        obtain(peers.back(), maps, shedding);
+    }
+
+    size_t done{};
+    while (done < blocks)
+    {
+        ++result.ticks;
+        for (auto& channel : peers)
+        {
+            if (!is_zero(channel.idle))
+            {
+                if (is_zero(--channel.idle))
+                    obtain(channel, maps, shedding);
+
+                continue;
+            }
+
+            const auto count = std::min(channel.rate, channel.inflight);
+            channel.inflight -= count;
+            done += count;
+
+            // Top up in flight from unrequested (request()).
+            if (shedding && channel.inflight <= depth / 2u)
+            {
+                const auto next = std::min(depth - channel.inflight,
+                    channel.unrequested);
+                channel.inflight += next;
+                channel.unrequested -= next;
+            }
+        }
+
+        for (auto& channel : peers)
+        {
+            if (!is_zero(channel.idle) || !is_zero(work(channel)))
+                continue;
+
+            obtain(channel, maps, shedding);
+            if (!is_zero(work(channel)))
+                continue;
+
+            // Starved, direct the slowest channel with divisible work.
+            auto slowest = peers.end();
+            for (auto it = peers.begin(); it != peers.end(); ++it)
+                if (is_zero(it->idle) && work(*it) > one &&
+                    (shedding ? !is_zero(it->unrequested) : true) &&
+                    (slowest == peers.end() || it->rate < slowest->rate))
+                    slowest = it;
+
+            if (slowest == peers.end())
+                continue;
+
+            if (shedding)
+            {
+                const auto shed = slowest->unrequested -
+                    slowest->unrequested / 2u;
+                slowest->unrequested -= shed;
+                maps.push_back(shed);
+                ++result.sheds;
+            }
+            else
+            {
+                // Both halves of all work (including in flight) to the pool.
+                const auto all = work(*slowest);
+                maps.push_back(all / 2u);
+                maps.push_back(all - all / 2u);
+                slowest->inflight = slowest->unrequested = zero;
+                slowest->idle = reconnect;
+                ++result.drops;
+            }
+
+            obtain(channel, maps, shedding);
+        }
+    }
+
+    return result;
+}
+
+static void report(const std::string& name, const outcome& result) NOEXCEPT
+{
+    BOOST_TEST_MESSAGE(name << ": " << result.ticks << " ticks ("
+        << test::per(blocks * 100u, result.ticks) << " blocks/s, "
+        << result.drops << " drops, " << result.sheds << " sheds).");
+}
+
+BOOST_AUTO_TEST_CASE(download__schedulers__benchmark)
+{
+    const auto split = simulate(false);
+    const auto shed = simulate(true);
+    report("split", split);
+    report("shed", shed);
+    BOOST_REQUIRE(shed.ticks <= split.ticks);
+}
+
+// End-game: block level simulation of a window tail with shedding, where a
+// starved channel is given duplicates of all outstanding blocks when the pool
+// is empty and no more than endgame blocks are outstanding. Late duplicates
+// are dropped on arrival (first arrival wins). Ticks are from the first
+// starved channel (window tail) to window completion.
+
+constexpr size_t window = 10'000;
+constexpr size_t endgame = 100;
+
+struct tail_peer
+{
+    size_t rate;
+    std::deque<size_t> inflight{};
+    std::deque<size_t> unrequested{};
+};
+
+struct tail_outcome
+{
+    size_t ticks{};
+    size_t tail{};
+    size_t duplicates{};
+};
+
+static tail_outcome simulate_tail(bool duplicate) NOEXCEPT
+{
+    tail_outcome result{};
+    std::vector<bool> done(window, false);
+    std::deque<std::deque<size_t>> maps{};
+    for (size_t block = 0; block < window; block += inventory / 10u)
+    {
+        maps.emplace_back();
+        for (auto id = block; id < std::min(block + inventory / 10u, window);
+            ++id)
+            maps.back().push_back(id);
+    }
+
+    const auto fill = [](tail_peer& channel) NOEXCEPT
+    {
+        while (channel.inflight.size() < depth && !channel.unrequested.empty())
+        {
+            channel.inflight.push_back(channel.unrequested.front());
+            channel.unrequested.pop_front();
+        }
+    };
+
+    const auto obtain = [&](tail_peer& channel) NOEXCEPT
+    {
+        if (maps.empty())
+            return;
+
+        channel.unrequested = std::move(maps.front());
+        maps.pop_front();
+        fill(channel);
+    };
+
+    std::vector<tail_peer> peers{};
+    for (const auto rate : rates)
+    {
+        peers.push_back({ rate });
+        obtain(peers.back());
+    }
+
+    size_t remaining{ window };
+    size_t starved{};
+    while (!is_zero(remaining))
+    {
+        ++result.ticks;
+        for (auto& channel : peers)
+        {
+            for (auto count = channel.rate; !is_zero(count) &&
+                !channel.inflight.empty(); --count)
+            {
+                const auto id = channel.inflight.front();
+                channel.inflight.pop_front();
+                if (done.at(id))
+                {
+                    ++result.duplicates;
+                    continue;
+                }
+
+                done.at(id) = true;
+                --remaining;
+            }
+
+            if (channel.inflight.size() <= depth / 2u)
+                fill(channel);
+        }
+
+        for (auto& channel : peers)
+        {
+            if (!channel.inflight.empty() || !channel.unrequested.empty())
+                continue;
+
+            if (is_zero(starved))
+                starved = result.ticks;
+
+            obtain(channel);
+            if (!channel.inflight.empty())
+                continue;
+
+            // End-game (set_endgame).
+            if (duplicate && maps.empty() && remaining <= endgame)
+            {
+                for (size_t id = 0; id < window; ++id)
+                    if (!done.at(id))
+                        channel.unrequested.push_back(id);
+
+                fill(channel);
+                continue;
+            }
+
+            // Shed (do_split), slowest channel with unrequested work.
+            auto slowest = peers.end();
+            for (auto it = peers.begin(); it != peers.end(); ++it)
+                if (!it->unrequested.empty() &&
+                    (slowest == peers.end() || it->rate < slowest->rate))
+                    slowest = it;
+
+            if (slowest == peers.end())
+                continue;
+
+            const auto kept = to_half(slowest->unrequested.size());
+            maps.emplace_back(std::next(slowest->unrequested.begin(), kept),
+                slowest->unrequested.end());
+            slowest->unrequested.resize(kept);
+            obtain(channel);
+        }
+    }
+
+    result.tail = result.ticks - starved;
+    return result;
+}
+
+static void report_tail(const std::string& name,
+    const tail_outcome& result) NOEXCEPT
+{
+    BOOST_TEST_MESSAGE(name << ": " << result.ticks << " ticks, tail ("
+        << result.tail << ") ticks, duplicates (" << result.duplicates
+        << ").");
+}
+
+BOOST_AUTO_TEST_CASE(download__endgame__benchmark)
+{
+    const auto normal = simulate_tail(false);
+    const auto endgamed = simulate_tail(true);
+    report_tail("shed", normal);
+    report_tail("shed + endgame", endgamed);
+    BOOST_TEST_MESSAGE("saved: " << (normal.ticks - endgamed.ticks)
+        << " ticks of window time.");
+    BOOST_REQUIRE(endgamed.ticks <= normal.ticks);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
@@ -0,0 +1,101 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "benchmarks.hpp"
+
+#if defined(HAVE_BENCHMARKS)
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include "corpus.hpp"
+
+BOOST_AUTO_TEST_SUITE(identify_benchmarks)
+
+using namespace system;
+
+// Times block identification as performed upon block receipt, the merkle root
+// (txids) by identify() and the witness commitment (wtxids) by identify(ctx),
+// over each mainnet-shaped corpus block. Hashing is implemented (and lane
+// vectorized, where available) by libbitcoin-system, so this measures the
+// ingest cost per block and its scaling across ingest threads. Corpus merkle
+// roots are not valid, but each root is fully computed before comparison.
+
+constexpr size_t rounds = 20;
+constexpr size_t threads[]{ 1, 2, 4, 8 };
+
+static chain::context witness_context() NOEXCEPT
+{
+    chain::context context{};
+    context.flags = chain::flags::bip141_rule;
+    return context;
+}
+
+static void report(const std::string& name, const data_chunk& data)
+{
+    const chain::block_view block{ data, true };
+    const auto context = witness_context();
+    const auto megabytes = to_floating(data.size()) / 1'000'000.0;
+
+    for (const auto count: threads)
+    {
+        std::atomic<size_t> failures{};
+        const auto ns = test::elapsed_ns([&]()
+        {
+            std::vector<std::thread> pool{};
+            for (size_t thread = 0; thread < count; ++thread)
+            {
+                pool.emplace_back([&]()
+                {
+                    for (size_t round = 0; round < rounds; ++round)
+                    {
+                        if (block.identify())
+                            ++failures;
+
+                        if (block.identify(context))
+                            ++failures;
+                    }
+                });
+            }
+
+            for (auto& thread: pool)
+                thread.join();
+        });
+
+        const auto total = count * rounds;
+        const auto seconds = to_floating(std::max<uint64_t>(ns, 1u)) / 1e9;
+        BOOST_TEST_MESSAGE(name << " threads (" << count << "): "
+            << test::per(ns, total) << " ns/block, "
+            << (to_floating(total) * megabytes / seconds) << " MB/s ("
+            << failures.load() << ").");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(identify__corpus__benchmark)
+{
+    const auto blocks = test::corpus::blocks();
+    report("genesis", blocks.at(0));
+    report("legacy", blocks.at(1));
+    report("segwit", blocks.at(2));
+    report("consolidation", blocks.at(3));
+    BOOST_REQUIRE(true);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
@@ -0,0 +1,116 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "benchmarks.hpp"
+
+#if defined(HAVE_BENCHMARKS)
+
+#include <algorithm>
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(numa_benchmarks)
+
+using namespace system;
+
+// Compare node bound and unbound block memory across pinned threads. On a
+// multi-socket machine run directly. On any machine with two or more nodes,
+// the unbound case can be forced remote by binding the process default policy
+// away from the executing node, which node bound arenas override, e.g.:
+// numactl --cpunodebind=0 --membind=1 libbitcoin-node-test
+//    --run_test=numa_benchmarks/numa__block_memory__benchmark
+
+struct record
+{
+    record* next;
+    uint64_t value[3];
+};
+
+constexpr size_t wire_size = 1'000'000;
+constexpr size_t multiple = 2;
+constexpr size_t records = wire_size / sizeof(record);
+constexpr size_t stride = 4099;
+constexpr size_t walks = 4;
+constexpr size_t blocks = 50;
+
+static uint64_t run_block(arena& memory)
+{
+    std::vector<record*> items(records);
+    const auto start = memory.start(wire_size);
+
+    for (auto& item : items)
+    {
+        item = pointer_cast<record>(memory.allocate(sizeof(record),
+            alignof(record)));
+        item->value[0] = 1;
+    }
+
+    for (size_t index = 0; index < records; ++index)
+        items[index]->next = items[(index * stride + 1u) % records];
+
+    uint64_t sum{};
+    for (size_t walk = 0; walk < walks; ++walk)
+        for (auto item = items.front(), count = records; !is_zero(count--);
+            item = item->next)
+            sum += item->value[0];
+
+    memory.detach();
+    memory.release(start);
+    return sum;
+}
+
+static void report(const std::string& name, bool per_node)
+{
+    const auto threads = std::max(std::thread::hardware_concurrency(), 1u);
+    block_memory memory{ multiple, threads, wire_size * multiple * 2u, zero,
+        per_node };
+
+    std::atomic<uint64_t> sum{};
+    const auto ns = test::elapsed_ns([&]()
+    {
+        std::vector<std::thread> workers{};
+        for (size_t thread = 0; thread < threads; ++thread)
+        {
+            workers.emplace_back([&, thread]()
+            {
+                numa::pin(thread % numa::nodes());
+                auto& local = *memory.get_arena();
+                for (size_t block = 0; block < blocks; ++block)
+                    sum += run_block(local);
+            });
+        }
+
+        for (auto& worker : workers)
+            worker.join();
+    });
+
+    BOOST_TEST_MESSAGE(name << ": " << test::per(ns, blocks) << " ns/round ("
+        << threads << " threads, " << memory.nodes() << " nodes, "
+        << memory.mapped() << " mapped, " << sum << ").");
+}
+
+BOOST_AUTO_TEST_CASE(numa__block_memory__benchmark)
+{
+    BOOST_TEST_MESSAGE("numa nodes: " << numa::nodes());
+    report("unbound", false);
+    report("node bound", true);
+    BOOST_REQUIRE(true);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
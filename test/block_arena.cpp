@@ -94,6 +94,13 @@ public:
         return to_aligned(value, align);
     }
 
+    static constexpr size_t to_band_(size_t wire_size) NOEXCEPT
+    {
+        return to_band(wire_size);
+    }
+
+    static constexpr size_t warmup_ = warmup;
+
     void* malloc_(size_t bytes) THROWS override
     {
         stack.emplace_back(bytes, 0xff_u8);
@@ -615,6 +622,130 @@ BOOST_AUTO_TEST_CASE(block_arena__capacity__allocated_overflow__expanded_zero)
     BOOST_REQUIRE_EQUAL(position, std::next(memory, link_size));
 }
 
+// to_band
+
+BOOST_AUTO_TEST_CASE(block_arena__to_band__boundaries__expected)
+{
+    static_assert(accessor::to_band_(0) == 0u);
+    static_assert(accessor::to_band_(65'535) == 0u);
+    static_assert(accessor::to_band_(65'536) == 1u);
+    static_assert(accessor::to_band_(262'143) == 1u);
+    static_assert(accessor::to_band_(262'144) == 2u);
+    static_assert(accessor::to_band_(1'000'000) == 2u);
+    static_assert(accessor::to_band_(1'000'001) == 3u);
+    static_assert(accessor::to_band_(max_size_t) == 3u);
+}
+
+// ratio/chain
+
+BOOST_AUTO_TEST_CASE(block_arena__ratio__unstarted__multiple)
+{
+    constexpr auto multiple = 10u;
+    const accessor instance{ multiple };
+    BOOST_REQUIRE_EQUAL(instance.ratio(zero), to_floating(multiple));
+    BOOST_REQUIRE_EQUAL(instance.ratio(max_size_t), to_floating(multiple));
+}
+
+BOOST_AUTO_TEST_CASE(block_arena__chain__unstarted__zero)
+{
+    const accessor instance{ 10 };
+    BOOST_REQUIRE_EQUAL(instance.chain(), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(block_arena__chain__single_chunks__one)
+{
+    constexpr auto size = 64u;
+    accessor instance{ 10 };
+
+    for (size_t cycle = 0; cycle < 3u; ++cycle)
+    {
+        BOOST_REQUIRE(!is_null(instance.start(size)));
+        BOOST_REQUIRE(!is_null(instance.allocate(size, 1)));
+        BOOST_REQUIRE_EQUAL(instance.detach(), link_size + size);
+    }
+
+    BOOST_REQUIRE_EQUAL(instance.chain(), 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(block_arena__chain__overflowed_chunks__two)
+{
+    constexpr auto size = 64u;
+    accessor instance{ 1 };
+
+    for (size_t cycle = 0; cycle < 3u; ++cycle)
+    {
+        BOOST_REQUIRE(!is_null(instance.start(size)));
+        BOOST_REQUIRE(!is_null(instance.allocate(size, 1)));
+        BOOST_REQUIRE_EQUAL(instance.detach(), two * link_size + size);
+    }
+
+    BOOST_REQUIRE_EQUAL(instance.chain(), 2.0);
+}
+
+BOOST_AUTO_TEST_CASE(block_arena__objects__allocations__expected)
+{
+    constexpr auto size = 64u;
+    accessor instance{ 1 };
+    BOOST_REQUIRE_EQUAL(instance.blocks(), zero);
+    BOOST_REQUIRE_EQUAL(instance.objects(), zero);
+
+    BOOST_REQUIRE(!is_null(instance.start(size)));
+    BOOST_REQUIRE(!is_null(instance.allocate(8, 1)));
+    BOOST_REQUIRE(!is_null(instance.allocate(8, 1)));
+    BOOST_REQUIRE(!is_null(instance.allocate(size, 1)));
+    instance.detach();
+
+    BOOST_REQUIRE_EQUAL(instance.blocks(), one);
+    BOOST_REQUIRE_EQUAL(instance.chunks(), two);
+    BOOST_REQUIRE_EQUAL(instance.objects(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(block_arena__padding__unaligned_allocations__expected)
+{
+    constexpr auto size = 64u;
+    accessor instance{ 1 };
+
+    // link(8) + 1 byte, then 8 aligned requires 7 bytes of padding.
+    BOOST_REQUIRE(!is_null(instance.start(size)));
+    BOOST_REQUIRE(!is_null(instance.allocate(1, 1)));
+    BOOST_REQUIRE(!is_null(instance.allocate(8, 8)));
+    BOOST_REQUIRE_EQUAL(instance.detach(), link_size + 1u + 7u + 8u);
+
+    BOOST_REQUIRE_EQUAL(instance.bytes(), link_size + 1u + 7u + 8u);
+    BOOST_REQUIRE_EQUAL(instance.padding(), 7u);
+}
+
+BOOST_AUTO_TEST_CASE(block_arena__start__warmed_up__learned_size)
+{
+    constexpr auto size = 64u;
+    constexpr auto multiple = 10u;
+    constexpr auto used = size - link_size;
+    accessor instance{ multiple };
+
+    // Static multiple is used until warmed up.
+    for (size_t cycle = 0; cycle < accessor::warmup_; ++cycle)
+    {
+        BOOST_REQUIRE(!is_null(instance.start(size)));
+        BOOST_REQUIRE_EQUAL(instance.get_size(), multiple * size);
+        BOOST_REQUIRE(!is_null(instance.allocate(used, 1)));
+        BOOST_REQUIRE_EQUAL(instance.detach(), size);
+    }
+
+    // Learned ratio converges around allocation/wire (1.0).
+    const auto ratio = instance.ratio(size);
+    BOOST_REQUIRE_LT(ratio, 1.01);
+    BOOST_REQUIRE_GT(ratio, 0.9);
+
+    // First chunk sized by learned ratio.
+    BOOST_REQUIRE(!is_null(instance.start(size)));
+    BOOST_REQUIRE_LT(instance.get_size(), multiple * size);
+    BOOST_REQUIRE_GE(instance.get_size(), link_size);
+    instance.detach();
+
+    // Other bands are unaffected.
+    BOOST_REQUIRE_EQUAL(instance.ratio(max_size_t), to_floating(multiple));
+}
+
 // do_allocate/do_deallocate
 
 BOOST_AUTO_TEST_CASE(block_arena__do_allocate__do_deallocate__expected)
@@ -18,6 +18,7 @@
  */
 #include "test.hpp"
 
+#include <memory>
 #include <thread>
 
 BOOST_AUTO_TEST_SUITE(block_memory_tests)
@@ -28,19 +29,19 @@ class accessor
 public:
     using block_memory::block_memory;
 
-    size_t get_count() const NOEXCEPT
+    size_t get_size() const NOEXCEPT
     {
-        return count_;
+        return registries_.front()->arenas.size();
     }
 
-    size_t get_size() const NOEXCEPT
+    size_t get_free() const NOEXCEPT
     {
-        return arenas_.size();
+        return registries_.front()->free.size();
     }
 
     arena* get_arena_at(size_t index) NOEXCEPT
     {
-        return &arenas_.at(index);
+        return &registries_.front()->arenas.at(index);
     }
 };
 
@@ -50,53 +51,77 @@ BOOST_AUTO_TEST_CASE(block_memory__get_arena__no_multiple_no_threads__default_ar
     constexpr size_t threads = 0;
     accessor instance{ multiple, threads };
     BOOST_REQUIRE_EQUAL(instance.get_size(), zero);
-    BOOST_REQUIRE_EQUAL(instance.get_count(), zero);
+    BOOST_REQUIRE_EQUAL(instance.assignments(), zero);
     BOOST_REQUIRE_EQUAL(instance.get_arena(), default_arena::get());
+    BOOST_REQUIRE_EQUAL(instance.assignments(), zero);
+    BOOST_REQUIRE_EQUAL(instance.fallbacks(), zero);
 }
 
-BOOST_AUTO_TEST_CASE(block_memory__get_arena__no_threads__default_arena)
+BOOST_AUTO_TEST_CASE(block_memory__get_arena__no_multiple__default_arena)
 {
-    constexpr size_t multiple = 42;
-    constexpr size_t threads = 0;
+    constexpr size_t multiple = 0;
+    constexpr size_t threads = 1;
     accessor instance{ multiple, threads };
     BOOST_REQUIRE_EQUAL(instance.get_size(), zero);
-    BOOST_REQUIRE_EQUAL(instance.get_count(), zero);
+    BOOST_REQUIRE_EQUAL(instance.assignments(), zero);
+    BOOST_REQUIRE_EQUAL(instance.get_arena(), default_arena::get());
     BOOST_REQUIRE_EQUAL(instance.get_arena(), default_arena::get());
+    BOOST_REQUIRE_EQUAL(instance.fallbacks(), zero);
 }
 
-BOOST_AUTO_TEST_CASE(block_memory__get_arena__no_multiple__default_arena)
+BOOST_AUTO_TEST_CASE(block_memory__get_arena__no_threads__lazy_arena)
 {
-    constexpr size_t multiple = 0;
-    constexpr size_t threads = 1;
+    constexpr size_t multiple = 42;
+    constexpr size_t threads = 0;
     accessor instance{ multiple, threads };
     BOOST_REQUIRE_EQUAL(instance.get_size(), zero);
-    BOOST_REQUIRE_EQUAL(instance.get_count(), zero);
-    BOOST_REQUIRE_EQUAL(instance.get_arena(), default_arena::get());
+    BOOST_REQUIRE_EQUAL(instance.assignments(), zero);
+    BOOST_REQUIRE_NE(instance.get_arena(), default_arena::get());
+    BOOST_REQUIRE_EQUAL(instance.get_size(), one);
+    BOOST_REQUIRE_EQUAL(instance.assignments(), one);
+    BOOST_REQUIRE_EQUAL(instance.fallbacks(), one);
 }
 
-BOOST_AUTO_TEST_CASE(block_memory__get_arena__multiple_one_thread__not_default_arena)
+BOOST_AUTO_TEST_CASE(block_memory__get_arena__multiple_one_thread__first_arena)
 {
     constexpr size_t multiple = 42;
     constexpr size_t threads = 1;
     accessor instance{ multiple, threads };
     BOOST_REQUIRE_EQUAL(instance.get_size(), one);
-    BOOST_REQUIRE_EQUAL(instance.get_count(), zero);
-    BOOST_REQUIRE_NE(instance.get_arena(), default_arena::get());
+    BOOST_REQUIRE_EQUAL(instance.get_free(), one);
+    BOOST_REQUIRE_EQUAL(instance.assignments(), zero);
+    BOOST_REQUIRE_EQUAL(instance.get_arena(), instance.get_arena_at(0));
+    BOOST_REQUIRE_EQUAL(instance.get_free(), zero);
+    BOOST_REQUIRE_EQUAL(instance.fallbacks(), zero);
 }
 
-BOOST_AUTO_TEST_CASE(block_memory__get_arena__multiple_threads__count_unincremented)
+BOOST_AUTO_TEST_CASE(block_memory__get_arena__repeated__same_arena_count_unincremented)
 {
     constexpr size_t multiple = 42;
     constexpr size_t threads = 2;
     accessor instance{ multiple, threads };
     BOOST_REQUIRE_EQUAL(instance.get_size(), two);
 
-    // On any given thread count must not change.
-    BOOST_REQUIRE_EQUAL(instance.get_count(), zero);
-    BOOST_REQUIRE_NE(instance.get_arena(), default_arena::get());
-    BOOST_REQUIRE_EQUAL(instance.get_count(), zero);
-    BOOST_REQUIRE_NE(instance.get_arena(), default_arena::get());
-    BOOST_REQUIRE_EQUAL(instance.get_count(), zero);
+    // On any given thread count changes only upon first call.
+    const auto first = instance.get_arena();
+    BOOST_REQUIRE_NE(first, default_arena::get());
+    BOOST_REQUIRE_EQUAL(instance.assignments(), one);
+    BOOST_REQUIRE_EQUAL(instance.get_arena(), first);
+    BOOST_REQUIRE_EQUAL(instance.assignments(), one);
+    BOOST_REQUIRE_EQUAL(instance.get_size(), two);
+}
+
+BOOST_AUTO_TEST_CASE(block_memory__get_arena__two_instances_one_thread__independent_arenas)
+{
+    constexpr size_t multiple = 42;
+    constexpr size_t threads = 1;
+    accessor instance1{ multiple, threads };
+    accessor instance2{ multiple, threads };
+    const auto arena1 = instance1.get_arena();
+    const auto arena2 = instance2.get_arena();
+    BOOST_REQUIRE_EQUAL(arena1, instance1.get_arena_at(0));
+    BOOST_REQUIRE_EQUAL(arena2, instance2.get_arena_at(0));
+    BOOST_REQUIRE_NE(arena1, arena2);
 }
 
 BOOST_AUTO_TEST_CASE(block_memory__get_arena__two_threads__independent_not_default_arenas)
@@ -105,19 +130,15 @@ BOOST_AUTO_TEST_CASE(block_memory__get_arena__two_threads__independent_not_defau
     constexpr size_t multiple = 42;
     constexpr size_t threads = 2;
     accessor instance{ multiple, threads };
-    size_t count1{};
-    size_t count2{};
     void* arena1{};
     void* arena2{};
 
     std::thread thread1([&]() NOEXCEPT
     {
-        count1 = instance.get_count();
         arena1 = instance.get_arena();
 
         std::thread thread2([&]() NOEXCEPT
         {
-            count2 = instance.get_count();
             arena2 = instance.get_arena();
         });
             
@@ -129,20 +150,14 @@ BOOST_AUTO_TEST_CASE(block_memory__get_arena__two_threads__independent_not_defau
     BOOST_REQUIRE_NE(arena2, default_arena::get());
     BOOST_REQUIRE_NE(arena1, default_arena::get());
     BOOST_REQUIRE_NE(arena1, arena2);
-    BOOST_REQUIRE_NE(count1, count2);
+    BOOST_REQUIRE_EQUAL(instance.assignments(), two);
 }
 
-BOOST_AUTO_TEST_CASE(block_memory__get_arena__overflow_threads__default_arena)
+BOOST_AUTO_TEST_CASE(block_memory__get_arena__overflow_threads__new_arena)
 {
     constexpr size_t multiple = 42;
     constexpr size_t threads = 2;
     accessor instance{ multiple, threads };
-    size_t count1a{};
-    size_t count1b{};
-    size_t count2a{};
-    size_t count2b{};
-    size_t count3a{};
-    size_t count3b{};
     void* arena1{};
     void* arena2{};
     void* arena3{};
@@ -150,21 +165,15 @@ BOOST_AUTO_TEST_CASE(block_memory__get_arena__overflow_threads__default_arena)
     // order is required to ensure third is the overflow.
     std::thread thread1([&]() NOEXCEPT
     {
-        count1a = instance.get_count();
         arena1 = instance.get_arena();
-        count1b = instance.get_count();
 
         std::thread thread2([&]() NOEXCEPT
         {
-            count2a = instance.get_count();
             arena2 = instance.get_arena();
-            count2b = instance.get_count();
 
             std::thread thread3([&]() NOEXCEPT
             {
-                count3a = instance.get_count();
                 arena3 = instance.get_arena();
-                count3b = instance.get_count();
             });
 
             thread3.join();
@@ -176,20 +185,136 @@ BOOST_AUTO_TEST_CASE(block_memory__get_arena__overflow_threads__default_arena)
     thread1.join();
 
     // Arenas are ordered by thread order above.
+    BOOST_REQUIRE_EQUAL(instance.get_size(), 3u);
     BOOST_REQUIRE_EQUAL(arena1, instance.get_arena_at(0));
     BOOST_REQUIRE_EQUAL(arena2, instance.get_arena_at(1));
-    BOOST_REQUIRE_NE(arena1, arena2);
+    BOOST_REQUIRE_EQUAL(arena3, instance.get_arena_at(2));
+
+    // Overflow is lazily created, not default arena.
+    BOOST_REQUIRE_NE(arena3, default_arena::get());
+    BOOST_REQUIRE_EQUAL(instance.assignments(), 3u);
+    BOOST_REQUIRE_EQUAL(instance.fallbacks(), one);
+
+    // All slots returned upon thread exit.
+    BOOST_REQUIRE_EQUAL(instance.get_free(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(block_memory__get_arena__exited_thread__slot_reused)
+{
+    constexpr size_t multiple = 42;
+    constexpr size_t threads = 1;
+    accessor instance{ multiple, threads };
+    void* arena1{};
+    void* arena2{};
+
+    std::thread thread1([&]() NOEXCEPT
+    {
+        arena1 = instance.get_arena();
+    });
+
+    thread1.join();
+    BOOST_REQUIRE_EQUAL(instance.get_free(), one);
+
+    std::thread thread2([&]() NOEXCEPT
+    {
+        arena2 = instance.get_arena();
+    });
+
+    thread2.join();
+    BOOST_REQUIRE_EQUAL(arena1, instance.get_arena_at(0));
+    BOOST_REQUIRE_EQUAL(arena1, arena2);
+    BOOST_REQUIRE_EQUAL(instance.get_size(), one);
+    BOOST_REQUIRE_EQUAL(instance.assignments(), two);
+}
+
+BOOST_AUTO_TEST_CASE(block_memory__get_arena__destroyed_before_thread_exit__safe)
+{
+    constexpr size_t multiple = 42;
+    constexpr size_t threads = 1;
+    auto instance = std::make_unique<accessor>(multiple, threads);
+    void* assigned{};
+
+    std::thread thread([&]() NOEXCEPT
+    {
+        assigned = instance->get_arena();
+        instance.reset();
+    });
 
-    // Index overflows to default arena.
-    BOOST_REQUIRE_EQUAL(arena3, default_arena::get());
+    thread.join();
+    BOOST_REQUIRE(!is_null(assigned));
+    BOOST_REQUIRE(!instance);
+}
 
-    // Count reflects total, not the index of the thread.
-    BOOST_REQUIRE_EQUAL(count1a, 0u);
-    BOOST_REQUIRE_EQUAL(count2a, 1u);
-    BOOST_REQUIRE_EQUAL(count3a, 2u);
-    BOOST_REQUIRE_EQUAL(count1b, 1u);
-    BOOST_REQUIRE_EQUAL(count2b, 2u);
-    BOOST_REQUIRE_EQUAL(count3b, 3u);
+BOOST_AUTO_TEST_CASE(block_memory__nodes__not_per_node__one)
+{
+    const accessor instance{ 42, 1 };
+    BOOST_REQUIRE_EQUAL(instance.nodes(), one);
+}
+
+BOOST_AUTO_TEST_CASE(block_memory__get_arena__per_node__local_node_arena)
+{
+    constexpr size_t multiple = 42;
+    constexpr size_t threads = 0;
+    accessor instance{ multiple, threads, zero, zero, true };
+    BOOST_REQUIRE_EQUAL(instance.nodes(), numa::nodes());
+    BOOST_REQUIRE_NE(instance.get_arena(), default_arena::get());
+    BOOST_REQUIRE_EQUAL(instance.assignments(), one);
+}
+
+// deserialize
+
+BOOST_AUTO_TEST_CASE(block_memory__deserialize__disabled__default_allocated)
+{
+    const auto data = system::settings{ system::chain::selection::mainnet }
+        .genesis_block.to_data(true);
+
+    accessor instance{ 0, 1 };
+    BOOST_REQUIRE(!instance.enabled());
+
+    const auto block = instance.deserialize(data, true);
+    BOOST_REQUIRE(block);
+    BOOST_REQUIRE_EQUAL(block->to_data(true), data);
+    BOOST_REQUIRE_EQUAL(instance.blocks(), zero);
+}
+
+BOOST_AUTO_TEST_CASE(block_memory__deserialize__enabled__arena_allocated)
+{
+    const auto data = system::settings{ system::chain::selection::mainnet }
+        .genesis_block.to_data(true);
+
+    accessor instance{ 5, 1 };
+    BOOST_REQUIRE(instance.enabled());
+
+    const auto block = instance.deserialize(data, true);
+    BOOST_REQUIRE(block);
+    BOOST_REQUIRE_EQUAL(block->to_data(true), data);
+    BOOST_REQUIRE_EQUAL(instance.blocks(), one);
+    BOOST_REQUIRE(is_nonzero(instance.objects()));
+}
+
+BOOST_AUTO_TEST_CASE(block_memory__deserialize__enabled_populated__prevouts_released)
+{
+    const auto data = system::settings{ system::chain::selection::mainnet }
+        .genesis_block.to_data(true);
+
+    accessor instance{ 5, 1 };
+    auto block = instance.deserialize(data, true);
+    BOOST_REQUIRE(block);
+
+    // Populated prevouts are heap allocated, not arena allocated.
+    const auto prevout = std::make_shared<const system::chain::output>();
+    const auto& tx = *block->transactions_ptr()->front();
+    tx.inputs_ptr()->front()->prevout = prevout;
+    BOOST_REQUIRE_EQUAL(prevout.use_count(), 2);
+
+    block.reset();
+    BOOST_REQUIRE_EQUAL(prevout.use_count(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(block_memory__deserialize__enabled_empty__nullptr)
+{
+    accessor instance{ 5, 1 };
+    BOOST_REQUIRE(!instance.deserialize({}, true));
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,277 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+#include <algorithm>
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(block_pool_tests)
+
+using namespace system;
+
+class accessor
+  : public block_pool
+{
+public:
+    using block_pool::block_pool;
+
+    static constexpr size_t unclassed_ = unclassed;
+    static constexpr size_t huge_page_ = huge_page;
+
+    static constexpr size_t to_class_(size_t bytes) NOEXCEPT
+    {
+        return to_class(bytes);
+    }
+
+    static constexpr size_t to_size_(size_t index) NOEXCEPT
+    {
+        return to_size(index);
+    }
+};
+
+// to_class/to_size
+
+BOOST_AUTO_TEST_CASE(block_pool__to_class__minimum_or_less__zero)
+{
+    BOOST_REQUIRE_EQUAL(accessor::to_class_(0), 0u);
+    BOOST_REQUIRE_EQUAL(accessor::to_class_(1), 0u);
+    BOOST_REQUIRE_EQUAL(accessor::to_class_(4096), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(block_pool__to_class__steps__expected)
+{
+    BOOST_REQUIRE_EQUAL(accessor::to_class_(4097), 1u);
+    BOOST_REQUIRE_EQUAL(accessor::to_class_(5120), 1u);
+    BOOST_REQUIRE_EQUAL(accessor::to_class_(5121), 2u);
+    BOOST_REQUIRE_EQUAL(accessor::to_class_(6144), 2u);
+    BOOST_REQUIRE_EQUAL(accessor::to_class_(7168), 3u);
+    BOOST_REQUIRE_EQUAL(accessor::to_class_(7169), 4u);
+    BOOST_REQUIRE_EQUAL(accessor::to_class_(8192), 4u);
+    BOOST_REQUIRE_EQUAL(accessor::to_class_(8193), 5u);
+}
+
+BOOST_AUTO_TEST_CASE(block_pool__to_size__steps__expected)
+{
+    BOOST_REQUIRE_EQUAL(accessor::to_size_(0), 4096u);
+    BOOST_REQUIRE_EQUAL(accessor::to_size_(1), 5120u);
+    BOOST_REQUIRE_EQUAL(accessor::to_size_(2), 6144u);
+    BOOST_REQUIRE_EQUAL(accessor::to_size_(3), 7168u);
+    BOOST_REQUIRE_EQUAL(accessor::to_size_(4), 8192u);
+    BOOST_REQUIRE_EQUAL(accessor::to_size_(5), 10240u);
+}
+
+BOOST_AUTO_TEST_CASE(block_pool__to_class__to_size__sufficient)
+{
+    for (size_t bytes = 1; bytes < 1'000'000; bytes += 997)
+    {
+        const auto index = accessor::to_class_(bytes);
+        BOOST_REQUIRE_GE(accessor::to_size_(index), bytes);
+        if (!is_zero(index))
+        {
+            BOOST_REQUIRE_LT(accessor::to_size_(sub1(index)), bytes);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(block_pool__to_class__excessive__unclassed)
+{
+    BOOST_REQUIRE_EQUAL(accessor::to_class_(max_size_t), accessor::unclassed_);
+}
+
+// allocate/deallocate
+
+BOOST_AUTO_TEST_CASE(block_pool__allocate__no_retention__misses)
+{
+    accessor instance{ zero };
+    const auto first = instance.allocate(100);
+    BOOST_REQUIRE(first != nullptr);
+    instance.deallocate(first);
+    BOOST_REQUIRE_EQUAL(instance.retained(), zero);
+
+    const auto second = instance.allocate(100);
+    BOOST_REQUIRE(second != nullptr);
+    instance.deallocate(second);
+    BOOST_REQUIRE_EQUAL(instance.hits(), zero);
+    BOOST_REQUIRE_EQUAL(instance.misses(), two);
+}
+
+BOOST_AUTO_TEST_CASE(block_pool__allocate__retained__hits_same_chunk)
+{
+    accessor instance{ 1'000'000 };
+    const auto first = instance.allocate(5000);
+    instance.deallocate(first);
+    BOOST_REQUIRE_EQUAL(instance.retained(), 5120u);
+
+    // Same size class reuses the chunk.
+    const auto second = instance.allocate(4500);
+    BOOST_REQUIRE_EQUAL(second, first);
+    BOOST_REQUIRE_EQUAL(instance.retained(), zero);
+    BOOST_REQUIRE_EQUAL(instance.hits(), one);
+    BOOST_REQUIRE_EQUAL(instance.misses(), one);
+    instance.deallocate(second);
+}
+
+BOOST_AUTO_TEST_CASE(block_pool__allocate__other_class__misses)
+{
+    accessor instance{ 1'000'000 };
+    const auto first = instance.allocate(5000);
+    instance.deallocate(first);
+
+    const auto second = instance.allocate(9000);
+    BOOST_REQUIRE_EQUAL(instance.hits(), zero);
+    BOOST_REQUIRE_EQUAL(instance.misses(), two);
+    instance.deallocate(second);
+}
+
+BOOST_AUTO_TEST_CASE(block_pool__deallocate__retention_exceeded__not_retained)
+{
+    accessor instance{ 4096 };
+    const auto first = instance.allocate(100);
+    const auto second = instance.allocate(100);
+    instance.deallocate(first);
+    instance.deallocate(second);
+    BOOST_REQUIRE_EQUAL(instance.retained(), 4096u);
+}
+
+BOOST_AUTO_TEST_CASE(block_pool__deallocate__nullptr__no_effect)
+{
+    accessor instance{ 4096 };
+    instance.deallocate(nullptr);
+    BOOST_REQUIRE_EQUAL(instance.retained(), zero);
+}
+
+BOOST_AUTO_TEST_CASE(block_pool__deallocate__other_thread__reclaimed_by_owner)
+{
+    accessor instance{ 1'000'000 };
+    const auto first = instance.allocate(5000);
+
+    std::thread thread([&]() NOEXCEPT
+    {
+        instance.deallocate(first);
+    });
+
+    thread.join();
+
+    // Returned chunks are not retained until reclaimed by the owner.
+    BOOST_REQUIRE_EQUAL(instance.retained(), zero);
+
+    const auto second = instance.allocate(5000);
+    BOOST_REQUIRE_EQUAL(second, first);
+    BOOST_REQUIRE_EQUAL(instance.hits(), one);
+    instance.deallocate(second);
+}
+
+// huge pages
+
+BOOST_AUTO_TEST_CASE(block_pool__allocate__below_huge_threshold__not_mapped)
+{
+    accessor instance{ zero, 1'000'000 };
+    const auto chunk = instance.allocate(5000);
+    BOOST_REQUIRE(chunk != nullptr);
+    BOOST_REQUIRE_EQUAL(instance.mapped(), zero);
+    instance.deallocate(chunk);
+}
+
+BOOST_AUTO_TEST_CASE(block_pool__allocate__below_huge_page__not_mapped)
+{
+    // The threshold is raised to the huge page size.
+    accessor instance{ zero, 4096 };
+    const auto chunk = instance.allocate(5000);
+    BOOST_REQUIRE(chunk != nullptr);
+    BOOST_REQUIRE_EQUAL(instance.mapped(), zero);
+    instance.deallocate(chunk);
+}
+
+BOOST_AUTO_TEST_CASE(block_pool__allocate__huge_threshold__mapped_and_recycled)
+{
+    constexpr auto size = accessor::huge_page_;
+    accessor instance{ two * size, 4096 };
+    const auto first = instance.allocate(size);
+    BOOST_REQUIRE(first != nullptr);
+
+    // Mapped memory is writable across the requested size.
+    std::fill_n(pointer_cast<uint8_t>(first), size, 0x42_u8);
+    instance.deallocate(first);
+
+    const auto second = instance.allocate(size);
+    BOOST_REQUIRE_EQUAL(second, first);
+    BOOST_REQUIRE_EQUAL(instance.hits(), one);
+    instance.deallocate(second);
+
+#if defined(HAVE_MSC)
+    BOOST_REQUIRE_EQUAL(instance.mapped(), zero);
+#else
+    BOOST_REQUIRE_EQUAL(instance.mapped(), one);
+#endif
+}
+
+// live/peak
+
+BOOST_AUTO_TEST_CASE(block_pool__live__allocate_deallocate__expected)
+{
+    accessor instance{ 1'000'000 };
+    BOOST_REQUIRE_EQUAL(instance.live(), zero);
+    BOOST_REQUIRE_EQUAL(instance.peak(), zero);
+
+    const auto first = instance.allocate(5000);
+    const auto one_live = instance.live();
+    BOOST_REQUIRE(one_live >= 5000u);
+
+    const auto second = instance.allocate(5000);
+    BOOST_REQUIRE_EQUAL(instance.live(), two * one_live);
+    BOOST_REQUIRE_EQUAL(instance.peak(), two * one_live);
+
+    instance.deallocate(first);
+    instance.deallocate(second);
+    BOOST_REQUIRE_EQUAL(instance.live(), zero);
+    BOOST_REQUIRE_EQUAL(instance.peak(), two * one_live);
+
+    // Recycled chunks are live again.
+    const auto third = instance.allocate(5000);
+    BOOST_REQUIRE_EQUAL(instance.live(), one_live);
+    BOOST_REQUIRE_EQUAL(instance.peak(), two * one_live);
+    instance.deallocate(third);
+}
+
+// numa
+
+BOOST_AUTO_TEST_CASE(block_pool__node__default__unbound)
+{
+    const accessor instance{ zero };
+    BOOST_REQUIRE_EQUAL(instance.node(), numa::unbound);
+}
+
+BOOST_AUTO_TEST_CASE(block_pool__allocate__node_bound__mapped)
+{
+    accessor instance{ zero, zero, numa::node() };
+    BOOST_REQUIRE_EQUAL(instance.node(), numa::node());
+
+    const auto chunk = instance.allocate(5000);
+    BOOST_REQUIRE(chunk != nullptr);
+    std::fill_n(pointer_cast<uint8_t>(chunk), 5000u, 0x42_u8);
+    instance.deallocate(chunk);
+
+#if defined(HAVE_MSC)
+    BOOST_REQUIRE_EQUAL(instance.mapped(), zero);
+#else
+    BOOST_REQUIRE_EQUAL(instance.mapped(), one);
+#endif
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,263 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(candidate_window_tests)
+
+using state = candidate_window::state;
+using header_link = database::header_link;
+
+BOOST_AUTO_TEST_CASE(candidate_window__construct__default__empty)
+{
+    const candidate_window instance{};
+    BOOST_REQUIRE_EQUAL(instance.floor(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE(instance.get(0, header_link{ 0 }) == state::unknown);
+}
+
+// set/get
+
+BOOST_AUTO_TEST_CASE(candidate_window__set__first__floor_unchanged)
+{
+    candidate_window instance{};
+    instance.advance(800'000);
+    instance.set(800'000, header_link{ 42 }, state::checked);
+    BOOST_REQUIRE_EQUAL(instance.floor(), 800'000u);
+    BOOST_REQUIRE_EQUAL(instance.size(), 1u);
+    BOOST_REQUIRE(instance.get(800'000, header_link{ 42 }) == state::checked);
+}
+
+BOOST_AUTO_TEST_CASE(candidate_window__set__out_of_order_after_advance__all_recorded)
+{
+    candidate_window instance{};
+    instance.advance(100);
+    instance.set(105, header_link{ 6 }, state::checked);
+    instance.set(100, header_link{ 1 }, state::checked);
+    instance.set(102, header_link{ 3 }, state::checked);
+    BOOST_REQUIRE_EQUAL(instance.floor(), 100u);
+    BOOST_REQUIRE_EQUAL(instance.size(), 6u);
+    BOOST_REQUIRE(instance.get(100, header_link{ 1 }) == state::checked);
+    BOOST_REQUIRE(instance.get(102, header_link{ 3 }) == state::checked);
+    BOOST_REQUIRE(instance.get(105, header_link{ 6 }) == state::checked);
+
+    // An emptied window retains its floor for out of order records.
+    instance.advance(200);
+    instance.set(203, header_link{ 4 }, state::checked);
+    instance.set(200, header_link{ 1 }, state::checked);
+    BOOST_REQUIRE_EQUAL(instance.floor(), 200u);
+    BOOST_REQUIRE(instance.get(200, header_link{ 1 }) == state::checked);
+    BOOST_REQUIRE(instance.get(203, header_link{ 4 }) == state::checked);
+}
+
+BOOST_AUTO_TEST_CASE(candidate_window__set__above__fills_unknown)
+{
+    candidate_window instance{};
+    instance.advance(100);
+    instance.set(100, header_link{ 1 }, state::checked);
+    instance.set(104, header_link{ 5 }, state::checked);
+    BOOST_REQUIRE_EQUAL(instance.size(), 5u);
+    BOOST_REQUIRE(instance.get(102, header_link{ 3 }) == state::unknown);
+    BOOST_REQUIRE(instance.get(104, header_link{ 5 }) == state::checked);
+    BOOST_REQUIRE(instance.get(105, header_link{ 6 }) == state::unknown);
+}
+
+BOOST_AUTO_TEST_CASE(candidate_window__set__below_floor__ignored)
+{
+    candidate_window instance{};
+    instance.advance(100);
+    instance.set(100, header_link{ 1 }, state::checked);
+    instance.set(99, header_link{ 0 }, state::checked);
+    BOOST_REQUIRE_EQUAL(instance.floor(), 100u);
+    BOOST_REQUIRE(instance.get(99, header_link{ 0 }) == state::unknown);
+}
+
+BOOST_AUTO_TEST_CASE(candidate_window__set__at_limit__ignored)
+{
+    candidate_window instance{ 10 };
+    instance.advance(100);
+    instance.set(109, header_link{ 10 }, state::checked);
+    instance.set(110, header_link{ 11 }, state::checked);
+    BOOST_REQUIRE_EQUAL(instance.size(), 10u);
+    BOOST_REQUIRE(instance.get(109, header_link{ 10 }) == state::checked);
+    BOOST_REQUIRE(instance.get(110, header_link{ 11 }) == state::unknown);
+
+    // The limit is relative to the floor.
+    instance.advance(101);
+    instance.set(110, header_link{ 11 }, state::checked);
+    BOOST_REQUIRE(instance.get(110, header_link{ 11 }) == state::checked);
+}
+
+BOOST_AUTO_TEST_CASE(candidate_window__set__unknown_or_terminal__ignored)
+{
+    candidate_window instance{};
+    instance.set(100, header_link{ 1 }, state::unknown);
+    instance.set(100, header_link{}, state::valid);
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(candidate_window__set__same_link__only_advances)
+{
+    candidate_window instance{};
+    instance.set(100, header_link{ 1 }, state::valid);
+    instance.set(100, header_link{ 1 }, state::checked);
+    BOOST_REQUIRE(instance.get(100, header_link{ 1 }) == state::valid);
+
+    instance.set(101, header_link{ 2 }, state::associated);
+    instance.set(101, header_link{ 2 }, state::checked);
+    BOOST_REQUIRE(instance.get(101, header_link{ 2 }) == state::checked);
+}
+
+BOOST_AUTO_TEST_CASE(candidate_window__get__other_link__unknown)
+{
+    candidate_window instance{};
+    instance.set(100, header_link{ 1 }, state::valid);
+    BOOST_REQUIRE(instance.get(100, header_link{ 2 }) == state::unknown);
+}
+
+BOOST_AUTO_TEST_CASE(candidate_window__set__other_link__replaces)
+{
+    candidate_window instance{};
+    instance.set(100, header_link{ 1 }, state::valid);
+    instance.set(100, header_link{ 2 }, state::associated);
+    BOOST_REQUIRE(instance.get(100, header_link{ 1 }) == state::unknown);
+    BOOST_REQUIRE(instance.get(100, header_link{ 2 }) == state::associated);
+}
+
+// claim/is_associated
+
+BOOST_AUTO_TEST_CASE(candidate_window__claim__unrecorded__true_recorded)
+{
+    candidate_window instance{};
+    BOOST_REQUIRE(instance.claim(100, header_link{ 1 }, state::claimed));
+    BOOST_REQUIRE(instance.get(100, header_link{ 1 }) == state::claimed);
+    BOOST_REQUIRE(!instance.is_associated(100, header_link{ 1 }));
+}
+
+BOOST_AUTO_TEST_CASE(candidate_window__claim__recorded__false)
+{
+    candidate_window instance{};
+    BOOST_REQUIRE(instance.claim(100, header_link{ 1 }, state::claimed));
+    BOOST_REQUIRE(!instance.claim(100, header_link{ 1 }, state::claimed));
+
+    instance.set(100, header_link{ 1 }, state::checked);
+    BOOST_REQUIRE(!instance.claim(100, header_link{ 1 }, state::claimed));
+    BOOST_REQUIRE(instance.is_associated(100, header_link{ 1 }));
+}
+
+BOOST_AUTO_TEST_CASE(candidate_window__claim__other_link__true)
+{
+    candidate_window instance{};
+    instance.set(100, header_link{ 1 }, state::checked);
+    BOOST_REQUIRE(instance.claim(100, header_link{ 2 }, state::claimed));
+}
+
+BOOST_AUTO_TEST_CASE(candidate_window__claim__below_floor__false)
+{
+    candidate_window instance{};
+    instance.advance(100);
+    instance.set(100, header_link{ 1 }, state::checked);
+    BOOST_REQUIRE(!instance.claim(99, header_link{ 2 }, state::claimed));
+    BOOST_REQUIRE(!instance.claim(99, header_link{ 2 }, state::claimed));
+}
+
+BOOST_AUTO_TEST_CASE(candidate_window__unclaim__claimed_failure__reclaimable)
+{
+    candidate_window instance{};
+    BOOST_REQUIRE(instance.claim(100, header_link{ 1 }, state::claimed));
+    BOOST_REQUIRE(!instance.claim(100, header_link{ 1 }, state::claimed));
+
+    // Archival failed, so the claim is released for a later download.
+    instance.unclaim(100, header_link{ 1 });
+    BOOST_REQUIRE(instance.get(100, header_link{ 1 }) == state::unknown);
+    BOOST_REQUIRE(instance.claim(100, header_link{ 1 }, state::claimed));
+    BOOST_REQUIRE(instance.get(100, header_link{ 1 }) == state::claimed);
+}
+
+BOOST_AUTO_TEST_CASE(candidate_window__unclaim__archived_or_other_link__unchanged)
+{
+    candidate_window instance{};
+    instance.set(100, header_link{ 1 }, state::checked);
+    instance.unclaim(100, header_link{ 1 });
+    BOOST_REQUIRE(instance.get(100, header_link{ 1 }) == state::checked);
+
+    BOOST_REQUIRE(instance.claim(101, header_link{ 2 }, state::claimed));
+    instance.unclaim(101, header_link{ 3 });
+    BOOST_REQUIRE(instance.get(101, header_link{ 2 }) == state::claimed);
+}
+
+BOOST_AUTO_TEST_CASE(candidate_window__claim__at_limit__true_unrecorded)
+{
+    candidate_window instance{ 10 };
+    instance.advance(100);
+    BOOST_REQUIRE(instance.claim(110, header_link{ 1 }, state::claimed));
+    BOOST_REQUIRE(instance.claim(110, header_link{ 1 }, state::claimed));
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+}
+
+// regress/advance
+
+BOOST_AUTO_TEST_CASE(candidate_window__regress__above_branch_point__discarded)
+{
+    candidate_window instance{};
+    instance.advance(100);
+    for (uint32_t height = 100; height < 110; ++height)
+        instance.set(height, header_link{ height }, state::checked);
+
+    instance.regress(104);
+    BOOST_REQUIRE_EQUAL(instance.size(), 5u);
+    BOOST_REQUIRE(instance.get(104, header_link{ 104 }) == state::checked);
+    BOOST_REQUIRE(instance.get(105, header_link{ 105 }) == state::unknown);
+}
+
+BOOST_AUTO_TEST_CASE(candidate_window__regress__below_floor__empty_lowered_floor)
+{
+    candidate_window instance{};
+    instance.advance(100);
+    instance.set(100, header_link{ 1 }, state::checked);
+    instance.regress(50);
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.floor(), 51u);
+
+    instance.set(60, header_link{ 2 }, state::checked);
+    BOOST_REQUIRE_EQUAL(instance.floor(), 51u);
+    BOOST_REQUIRE(instance.get(60, header_link{ 2 }) == state::checked);
+}
+
+BOOST_AUTO_TEST_CASE(candidate_window__advance__below_height__discarded)
+{
+    candidate_window instance{};
+    instance.advance(100);
+    for (uint32_t height = 100; height < 110; ++height)
+        instance.set(height, header_link{ height }, state::checked);
+
+    instance.advance(103);
+    BOOST_REQUIRE_EQUAL(instance.floor(), 103u);
+    BOOST_REQUIRE_EQUAL(instance.size(), 7u);
+    BOOST_REQUIRE(instance.get(102, header_link{ 102 }) == state::unknown);
+    BOOST_REQUIRE(instance.get(103, header_link{ 103 }) == state::checked);
+
+    instance.advance(50);
+    BOOST_REQUIRE_EQUAL(instance.floor(), 103u);
+
+    instance.advance(200);
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.floor(), 200u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,147 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+#include <cmath>
+
+BOOST_AUTO_TEST_SUITE(channel_speeds_tests)
+
+BOOST_AUTO_TEST_CASE(channel_speeds__construct__default__empty)
+{
+    channel_speeds instance{};
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.sum(), 0.0);
+    BOOST_REQUIRE_EQUAL(instance.mean(), 0.0);
+    BOOST_REQUIRE_EQUAL(instance.variance(), 0.0);
+    BOOST_REQUIRE_EQUAL(instance.median(), 0.0);
+    BOOST_REQUIRE_EQUAL(instance.mad(), 0.0);
+
+    object_key channel{};
+    BOOST_REQUIRE(!instance.slowest(channel));
+}
+
+BOOST_AUTO_TEST_CASE(channel_speeds__update__unsmoothed__replaces)
+{
+    channel_speeds instance{};
+    BOOST_REQUIRE_EQUAL(instance.update(1, 10.0), 10.0);
+    BOOST_REQUIRE_EQUAL(instance.update(1, 20.0), 20.0);
+    BOOST_REQUIRE_EQUAL(instance.size(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.sum(), 20.0);
+}
+
+BOOST_AUTO_TEST_CASE(channel_speeds__update__smoothed__weighted)
+{
+    channel_speeds instance{ 0.25 };
+    BOOST_REQUIRE_EQUAL(instance.update(1, 100.0), 100.0);
+    BOOST_REQUIRE_EQUAL(instance.update(1, 20.0), 80.0);
+    BOOST_REQUIRE_EQUAL(instance.sum(), 80.0);
+}
+
+BOOST_AUTO_TEST_CASE(channel_speeds__update__invalid_smoothing__unsmoothed)
+{
+    channel_speeds zero_weight{ 0.0 };
+    zero_weight.update(1, 100.0);
+    BOOST_REQUIRE_EQUAL(zero_weight.update(1, 20.0), 20.0);
+
+    channel_speeds over_weight{ 2.0 };
+    over_weight.update(1, 100.0);
+    BOOST_REQUIRE_EQUAL(over_weight.update(1, 20.0), 20.0);
+}
+
+BOOST_AUTO_TEST_CASE(channel_speeds__statistics__four_channels__expected)
+{
+    channel_speeds instance{};
+    instance.update(1, 2.0);
+    instance.update(2, 4.0);
+    instance.update(3, 4.0);
+    instance.update(4, 6.0);
+    BOOST_REQUIRE_EQUAL(instance.sum(), 16.0);
+    BOOST_REQUIRE_EQUAL(instance.mean(), 4.0);
+
+    // Sample variance: (4 + 0 + 0 + 4) / 3.
+    BOOST_REQUIRE_CLOSE(instance.variance(), 8.0 / 3.0, 0.0001);
+    BOOST_REQUIRE_CLOSE(instance.deviation(), std::sqrt(8.0 / 3.0), 0.0001);
+
+    // Upper median of { 2, 4, 4, 6 } and of deviations { 0, 0, 2, 2 }.
+    BOOST_REQUIRE_EQUAL(instance.median(), 4.0);
+    BOOST_REQUIRE_EQUAL(instance.mad(), 2.0);
+}
+
+BOOST_AUTO_TEST_CASE(channel_speeds__update__existing__incremental)
+{
+    channel_speeds instance{};
+    instance.update(1, 2.0);
+    instance.update(2, 4.0);
+    instance.update(3, 6.0);
+    instance.update(2, 10.0);
+    BOOST_REQUIRE_EQUAL(instance.sum(), 18.0);
+    BOOST_REQUIRE_EQUAL(instance.mean(), 6.0);
+}
+
+BOOST_AUTO_TEST_CASE(channel_speeds__median__fast_outlier__robust)
+{
+    channel_speeds instance{};
+    instance.update(1, 10.0);
+    instance.update(2, 11.0);
+    instance.update(3, 12.0);
+    instance.update(4, 13.0);
+    instance.update(5, 1000.0);
+    BOOST_REQUIRE_EQUAL(instance.median(), 12.0);
+    BOOST_REQUIRE_EQUAL(instance.mad(), 1.0);
+    BOOST_REQUIRE_GT(instance.mean(), 200.0);
+}
+
+BOOST_AUTO_TEST_CASE(channel_speeds__erase__existing__removed)
+{
+    channel_speeds instance{};
+    instance.update(1, 2.0);
+    instance.update(2, 4.0);
+    BOOST_REQUIRE(instance.erase(1));
+    BOOST_REQUIRE(!instance.erase(1));
+    BOOST_REQUIRE_EQUAL(instance.size(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.sum(), 4.0);
+    BOOST_REQUIRE_EQUAL(instance.median(), 4.0);
+
+    BOOST_REQUIRE(instance.erase(2));
+    BOOST_REQUIRE_EQUAL(instance.sum(), 0.0);
+    BOOST_REQUIRE_EQUAL(instance.median(), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(channel_speeds__slowest__populated__lowest)
+{
+    channel_speeds instance{};
+    instance.update(1, 5.0);
+    instance.update(2, 3.0);
+    instance.update(3, 7.0);
+
+    object_key channel{};
+    BOOST_REQUIRE(instance.slowest(channel));
+    BOOST_REQUIRE_EQUAL(channel, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(channel_speeds__speed__found__smoothed_else_zero)
+{
+    channel_speeds instance{ 0.5 };
+    instance.update(1, 4.0);
+    instance.update(1, 2.0);
+    BOOST_REQUIRE_EQUAL(instance.speed(1), 3.0);
+    BOOST_REQUIRE_EQUAL(instance.speed(2), 0.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
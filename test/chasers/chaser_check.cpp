@@ -25,4 +25,35 @@ BOOST_AUTO_TEST_CASE(chaser_check_test)
     BOOST_REQUIRE(true);
 }
 
+BOOST_AUTO_TEST_CASE(chaser_check__estimate_block_size__genesis__small)
+{
+    BOOST_REQUIRE_EQUAL(chaser_check::estimate_block_size(0), 250u);
+    BOOST_REQUIRE_EQUAL(chaser_check::estimate_block_size(49'999), 250u);
+}
+
+BOOST_AUTO_TEST_CASE(chaser_check__estimate_block_size__intervals__nondecreasing_to_segwit)
+{
+    for (size_t height = 50'000; height < 650'000; height += 50'000)
+        BOOST_REQUIRE_GE(chaser_check::estimate_block_size(height),
+            chaser_check::estimate_block_size(height - 50'000));
+}
+
+BOOST_AUTO_TEST_CASE(chaser_check__estimate_block_size__above_model__last)
+{
+    BOOST_REQUIRE_EQUAL(chaser_check::estimate_block_size(800'000), 1'700'000u);
+    BOOST_REQUIRE_EQUAL(chaser_check::estimate_block_size(max_size_t), 1'700'000u);
+}
+
+BOOST_AUTO_TEST_CASE(chaser_check__is_modeled__mainnet__true)
+{
+    const system::settings settings{ system::chain::selection::mainnet };
+    BOOST_REQUIRE(chaser_check::is_modeled(settings));
+}
+
+BOOST_AUTO_TEST_CASE(chaser_check__is_modeled__regtest__false)
+{
+    const system::settings settings{ system::chain::selection::regtest };
+    BOOST_REQUIRE(!chaser_check::is_modeled(settings));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -128,6 +128,15 @@ BOOST_AUTO_TEST_CASE(error_t__code__suspended_service__true_expected_message)
     BOOST_REQUIRE_EQUAL(ec.message(), "sacrificed service");
 }
 
+BOOST_AUTO_TEST_CASE(error_t__code__disfavored_channel__true_expected_message)
+{
+    constexpr auto value = error::disfavored_channel;
+    const auto ec = code(value);
+    BOOST_REQUIRE(ec);
+    BOOST_REQUIRE(ec == value);
+    BOOST_REQUIRE_EQUAL(ec.message(), "disfavored channel");
+}
+
 // blockchain
 
 BOOST_AUTO_TEST_CASE(error_t__code__orphan_block__true_expected_message)
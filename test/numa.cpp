@@ -0,0 +1,49 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_AUTO_TEST_SUITE(numa_tests)
+
+BOOST_AUTO_TEST_CASE(numa__nodes__always__nonzero)
+{
+    BOOST_REQUIRE(is_nonzero(numa::nodes()));
+}
+
+BOOST_AUTO_TEST_CASE(numa__node__always__less_than_nodes)
+{
+    BOOST_REQUIRE_LT(numa::node(), numa::nodes());
+}
+
+BOOST_AUTO_TEST_CASE(numa__bind__nullptr__false)
+{
+    BOOST_REQUIRE(!numa::bind(nullptr, 4096, zero));
+}
+
+BOOST_AUTO_TEST_CASE(numa__bind__unbound__false)
+{
+    uint8_t byte{};
+    BOOST_REQUIRE(!numa::bind(&byte, one, numa::unbound));
+}
+
+BOOST_AUTO_TEST_CASE(numa__pin__missing_node__false)
+{
+    BOOST_REQUIRE(!numa::pin(numa::unbound));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,217 @@
+/**
+ * Copyright (c) 2011-2026 libbitcoin developers
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "test.hpp"
+
+BOOST_FIXTURE_TEST_SUITE(peer_reputation_tests, test::directory_setup_fixture)
+
+const std::string fast{ "1.2.3.4:8333" };
+const std::string slow{ "5.6.7.8:8333" };
+const std::string other{ "[2001:db8::1]:8333" };
+
+BOOST_AUTO_TEST_CASE(peer_reputation__construct__default__empty)
+{
+    const peer_reputation instance{};
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.score(fast), 0.0);
+    BOOST_REQUIRE_EQUAL(instance.rank(fast), 0.5);
+    BOOST_REQUIRE(!instance.is_poor(fast));
+}
+
+BOOST_AUTO_TEST_CASE(peer_reputation__to_key__streamable__serialized_host)
+{
+    BOOST_REQUIRE_EQUAL(peer_reputation::to_key(fast), "1.2.3.4");
+    BOOST_REQUIRE_EQUAL(peer_reputation::to_key(other), "2001:db8::1");
+    BOOST_REQUIRE_EQUAL(peer_reputation::to_key(42), "42");
+}
+
+BOOST_AUTO_TEST_CASE(peer_reputation__to_host__portless__unchanged)
+{
+    BOOST_REQUIRE_EQUAL(peer_reputation::to_host("1.2.3.4"), "1.2.3.4");
+    BOOST_REQUIRE_EQUAL(peer_reputation::to_host("2001:db8::1"), "2001:db8::1");
+    BOOST_REQUIRE_EQUAL(peer_reputation::to_host("[2001:db8::1"), "[2001:db8::1");
+    BOOST_REQUIRE_EQUAL(peer_reputation::to_host(""), "");
+}
+
+BOOST_AUTO_TEST_CASE(peer_reputation__to_key__inbound_ports__same_key)
+{
+    BOOST_REQUIRE_EQUAL(peer_reputation::to_key("1.2.3.4:51234"),
+        peer_reputation::to_key("1.2.3.4:8333"));
+}
+
+// record
+
+BOOST_AUTO_TEST_CASE(peer_reputation__delivered__first__unsmoothed)
+{
+    peer_reputation instance{ 10, 0.5 };
+    instance.delivered(fast, 100.0);
+    BOOST_REQUIRE_EQUAL(instance.size(), 1u);
+    BOOST_REQUIRE_EQUAL(instance.score(fast), 100.0);
+}
+
+BOOST_AUTO_TEST_CASE(peer_reputation__delivered__subsequent__smoothed)
+{
+    peer_reputation instance{ 10, 0.5 };
+    instance.delivered(fast, 100.0);
+    instance.delivered(fast, 200.0);
+    BOOST_REQUIRE_EQUAL(instance.score(fast), 150.0);
+}
+
+BOOST_AUTO_TEST_CASE(peer_reputation__delivered__zero__ignored)
+{
+    peer_reputation instance{};
+    instance.delivered(fast, 0.0);
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(peer_reputation__stalled_dropped__discount_score)
+{
+    peer_reputation instance{ 10, 1.0 };
+    instance.delivered(fast, 300.0);
+    instance.stalled(fast);
+    BOOST_REQUIRE_EQUAL(instance.score(fast), 150.0);
+    instance.dropped(fast);
+    BOOST_REQUIRE_EQUAL(instance.score(fast), 100.0);
+}
+
+BOOST_AUTO_TEST_CASE(peer_reputation__is_poor__failures_exceed_samples__true)
+{
+    peer_reputation instance{};
+    instance.delivered(slow, 10.0);
+    instance.stalled(slow);
+    instance.dropped(slow);
+    BOOST_REQUIRE(!instance.is_poor(slow));
+    instance.stalled(slow);
+    BOOST_REQUIRE(instance.is_poor(slow));
+    instance.delivered(slow, 10.0);
+    instance.delivered(slow, 10.0);
+    BOOST_REQUIRE(!instance.is_poor(slow));
+}
+
+// rank
+
+BOOST_AUTO_TEST_CASE(peer_reputation__rank__recorded__midrank)
+{
+    peer_reputation instance{};
+    instance.delivered(fast, 300.0);
+    instance.delivered(slow, 100.0);
+    instance.delivered(other, 200.0);
+    BOOST_REQUIRE_EQUAL(instance.rank(slow), 0.5 / 3.0);
+    BOOST_REQUIRE_EQUAL(instance.rank(other), 0.5);
+    BOOST_REQUIRE_EQUAL(instance.rank(fast), 2.5 / 3.0);
+    BOOST_REQUIRE_EQUAL(instance.rank("9.9.9.9:8333"), 0.5);
+}
+
+BOOST_AUTO_TEST_CASE(peer_reputation__rank__singleton_or_equal__median)
+{
+    peer_reputation instance{};
+    instance.delivered(fast, 300.0);
+    BOOST_REQUIRE_EQUAL(instance.rank(fast), 0.5);
+
+    instance.delivered(slow, 300.0);
+    BOOST_REQUIRE_EQUAL(instance.rank(fast), 0.5);
+    BOOST_REQUIRE_EQUAL(instance.rank(slow), 0.5);
+}
+
+// capacity
+
+BOOST_AUTO_TEST_CASE(peer_reputation__delivered__over_capacity__evicts_least_evidence)
+{
+    peer_reputation instance{ 2 };
+    instance.delivered(fast, 300.0);
+    instance.delivered(fast, 300.0);
+    instance.delivered(slow, 100.0);
+    instance.delivered(other, 200.0);
+    BOOST_REQUIRE_EQUAL(instance.size(), 2u);
+    BOOST_REQUIRE_EQUAL(instance.score(fast), 300.0);
+    BOOST_REQUIRE_EQUAL(instance.score(slow), 0.0);
+    BOOST_REQUIRE_EQUAL(instance.score(other), 200.0);
+}
+
+// persistence
+
+BOOST_AUTO_TEST_CASE(peer_reputation__load__missing__false_unchanged)
+{
+    peer_reputation instance{};
+    instance.delivered(fast, 100.0);
+    BOOST_REQUIRE(!instance.load(TEST_PATH));
+    BOOST_REQUIRE_EQUAL(instance.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(peer_reputation__save_load__round_trip__halves_counts)
+{
+    const std::filesystem::path file{ TEST_PATH };
+    peer_reputation saved{};
+    saved.delivered(fast, 1000.0);
+    saved.delivered(fast, 1000.0);
+    for (auto stall = 0; stall < 6; ++stall)
+        saved.stalled(slow);
+
+    BOOST_REQUIRE(saved.is_poor(slow));
+    BOOST_REQUIRE(saved.save(file));
+    BOOST_REQUIRE(test::exists(file));
+
+    peer_reputation loaded{};
+    BOOST_REQUIRE(loaded.load(file));
+    BOOST_REQUIRE_EQUAL(loaded.size(), 2u);
+    BOOST_REQUIRE_EQUAL(loaded.score(fast), 1000.0);
+
+    // Six stalls are aged to three, which remains poor (no samples).
+    BOOST_REQUIRE(loaded.is_poor(slow));
+    BOOST_REQUIRE(loaded.save(file));
+
+    // Three stalls are aged to one, which is no longer poor.
+    peer_reputation aged{};
+    BOOST_REQUIRE(aged.load(file));
+    BOOST_REQUIRE(!aged.is_poor(slow));
+}
+
+BOOST_AUTO_TEST_CASE(peer_reputation__save_load__over_capacity__retains_most_evidence)
+{
+    const std::filesystem::path file{ TEST_PATH };
+    peer_reputation saved{ 2 };
+    saved.delivered(fast, 10.0);
+    saved.delivered(fast, 10.0);
+    saved.delivered(fast, 10.0);
+    saved.stalled(slow);
+    saved.stalled(slow);
+    saved.delivered(other, 10.0);
+    BOOST_REQUIRE(saved.save(file));
+
+    peer_reputation loaded{};
+    BOOST_REQUIRE(loaded.load(file));
+    BOOST_REQUIRE_EQUAL(loaded.size(), 2u);
+    BOOST_REQUIRE_EQUAL(loaded.score(fast), 10.0);
+    BOOST_REQUIRE_EQUAL(loaded.score(other), 10.0);
+    BOOST_REQUIRE_EQUAL(loaded.score(slow), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(peer_reputation__load__invalid__false_unchanged)
+{
+    const std::filesystem::path file{ TEST_PATH };
+    {
+        std::ofstream stream{ file };
+        stream << fast << " 100 1 0 0\n" << slow << " fast\n";
+    }
+
+    peer_reputation instance{};
+    BOOST_REQUIRE(!instance.load(file));
+    BOOST_REQUIRE_EQUAL(instance.size(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -31,6 +31,7 @@ BOOST_AUTO_TEST_CASE(settings__node__default_context__expected)
 
     const node::settings node{};
     BOOST_REQUIRE_EQUAL(node.threads, 1_u32);
+    BOOST_REQUIRE_EQUAL(node.ingest_threads, 0_u32);
     BOOST_REQUIRE_EQUAL(node.delay_inbound, true);
     BOOST_REQUIRE_EQUAL(node.headers_first, true);
     BOOST_REQUIRE_EQUAL(node.memory_priority, true);
@@ -42,10 +43,22 @@ BOOST_AUTO_TEST_CASE(settings__node__default_context__expected)
     BOOST_REQUIRE_EQUAL(node.require_witness, true);
     BOOST_REQUIRE_EQUAL(node.provide_filters, false);
     BOOST_REQUIRE_EQUAL(node.limited_blocks, false);
+    BOOST_REQUIRE_EQUAL(node.numa_memory, false);
+    BOOST_REQUIRE_EQUAL(node.numa_pinning, false);
+    BOOST_REQUIRE_EQUAL(node.median_deviation, false);
     BOOST_REQUIRE_EQUAL(node.minimum_fee_rate, 0.0);
     BOOST_REQUIRE_EQUAL(node.minimum_bump_rate, 0.0);
     BOOST_REQUIRE_EQUAL(node.allowed_deviation, 1.5);
+    BOOST_REQUIRE_EQUAL(node.speed_smoothing, 0.5);
+    BOOST_REQUIRE_EQUAL(node.stall_factor, 0.0);
     BOOST_REQUIRE_EQUAL(node.batch_signatures, 0_u64);
+    BOOST_REQUIRE_EQUAL(node.huge_page_threshold, 0_u64);
+    BOOST_REQUIRE_EQUAL(node.allocation_multiple, 0_u32);
+    BOOST_REQUIRE_EQUAL(node.inbound_allocation_multiple, 0_u32);
+    BOOST_REQUIRE_EQUAL(node.allocation_retain, 33'554'432_u64);
+    BOOST_REQUIRE_EQUAL(node.download_map_bytes, 33'554'432_u64);
+    BOOST_REQUIRE_EQUAL(node.lookahead_bytes, 0_u64);
+    BOOST_REQUIRE(node.reputation_file.empty());
     BOOST_REQUIRE_EQUAL(node.announcement_cache, 42_u16);
     BOOST_REQUIRE_EQUAL(node.fee_estimate_horizon, 0u);
     BOOST_REQUIRE_EQUAL(node.maximum_height, 0_u32);
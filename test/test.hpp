@@ -33,6 +33,10 @@
 #define TEST_PATH \
     TEST_DIRECTORY + "/" + TEST_NAME
 
+// Benchmark suites (test/benchmarks) are compiled only if HAVE_BENCHMARKS is
+// defined (--with-benchmarks or -Dwith-benchmarks=ON), and are run as
+// --run_test=*_benchmarks.
+
 #ifdef HAVE_MSC
     BC_DISABLE_WARNING(NO_ARRAY_INDEXING)
     BC_DISABLE_WARNING(NO_GLOBAL_INIT_CALLS)